@@ -0,0 +1,11 @@
+#ifndef ALLOCATIONCOUNTER_H
+#define ALLOCATIONCOUNTER_H
+
+#include <cstdint>
+
+// Kiek kartų kviestas operator new nuo programos pradžios. Skaičiuojantys new/delete pakeitimai
+// yra AllocationCounter.cpp; jis jungiamas tik į mikrotestus, o atskirame vertimo vienete
+// kompiliatorius nemato malloc/free porų ir neįspėja apie nesuderintus new/delete.
+uint64_t getAllocationCount();
+
+#endif // ALLOCATIONCOUNTER_H
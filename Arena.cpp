@@ -0,0 +1,172 @@
+#include "Arena.h"
+#include <algorithm>
+
+Arena::Arena(int width, int height, size_t snakes, size_t foodCount, uint64_t seed)
+    : width(width), height(height), owners(static_cast<size_t>(width) * height, 0), occupied(width, height),
+      food(width, height), foodCount(foodCount), bodies(snakes), directions(snakes, RIGHT), pendingGrowth(snakes, 0),
+      scores(snakes, 0), alive(snakes, 0), nextHeads(snakes), eats(snakes, 0), dying(snakes, 0),
+      claimTicks(static_cast<size_t>(width) * height, 0), claimOwners(static_cast<size_t>(width) * height, 0),
+      tick(0), random(seed), respawn(true) {
+    reset();
+}
+
+void Arena::reset() {
+    std::fill(owners.begin(), owners.end(), 0);
+    std::fill(claimTicks.begin(), claimTicks.end(), 0);
+    occupied.reset();
+    food.clear();
+    tick = 0;
+    for (size_t snake = 0; snake < bodies.size(); ++snake) {
+        bodies[snake].clear();
+        alive[snake] = 0;
+        spawn(snake);
+    }
+    while (food.size() < foodCount && occupied.getFreeCount() > 0) {
+        placeFood();
+    }
+}
+
+void Arena::spawn(size_t snake) {
+    if (occupied.getFreeCount() == 0) {
+        return;
+    }
+    Cell cell = occupied.getFreeCell(random.below(static_cast<uint32_t>(occupied.getFreeCount())));
+    bodies[snake].clear();
+    bodies[snake].pushFront(cell);
+    owners[index(cell)] = static_cast<uint16_t>(snake + 1);
+    occupied.set(cell);
+    directions[snake] = static_cast<Direction>(random.below(4));
+    pendingGrowth[snake] = 0;
+    scores[snake] = 0;
+    alive[snake] = 1;
+}
+
+void Arena::kill(size_t snake) {
+    // The body leaves the board at once; the cells become free for food and other snakes
+    for (Cell cell : bodies[snake]) {
+        if (occupied.contains(cell) && owners[index(cell)] == snake + 1) {
+            owners[index(cell)] = 0;
+            occupied.clear(cell);
+        }
+    }
+    bodies[snake].clear();
+    alive[snake] = 0;
+}
+
+void Arena::placeFood() {
+    Cell cell = occupied.getFreeCell(random.below(static_cast<uint32_t>(occupied.getFreeCount())));
+    food.add(cell);
+    occupied.set(cell);
+}
+
+void Arena::step(const Direction* actions) {
+    ++tick;
+    size_t snakes = bodies.size();
+
+    // Move every head and release the tails first, so a head may enter a cell freed this tick
+    for (size_t snake = 0; snake < snakes; ++snake) {
+        dying[snake] = 0;
+        if (!alive[snake]) {
+            continue;
+        }
+        directions[snake] = applyTurn(directions[snake], actions[snake]);
+        Cell head = moveCell(bodies[snake].front(), directions[snake]);
+        nextHeads[snake] = head;
+        eats[snake] = occupied.contains(head) && food.contains(head);
+        if (eats[snake]) {
+            pendingGrowth[snake] += GROWTH_PER_FOOD;
+        }
+        if (pendingGrowth[snake] > 0) {
+            --pendingGrowth[snake];
+        } else {
+            Cell tail = bodies[snake].back();
+            owners[index(tail)] = 0;
+            occupied.clear(tail);
+            bodies[snake].popBack();
+        }
+    }
+
+    // One pass over the heads: a wall or any body kills, and the second head to claim a cell
+    // kills both itself and the snake that claimed it first
+    for (size_t snake = 0; snake < snakes; ++snake) {
+        if (!alive[snake]) {
+            continue;
+        }
+        Cell head = nextHeads[snake];
+        if (!occupied.contains(head) || owners[index(head)] != 0) {
+            dying[snake] = 1;
+            continue;
+        }
+        size_t i = index(head);
+        if (claimTicks[i] == tick) {
+            dying[snake] = 1;
+            dying[claimOwners[i]] = 1;
+        } else {
+            claimTicks[i] = tick;
+            claimOwners[i] = static_cast<uint16_t>(snake);
+        }
+    }
+
+    for (size_t snake = 0; snake < snakes; ++snake) {
+        if (!alive[snake]) {
+            continue;
+        }
+        if (dying[snake]) {
+            kill(snake);
+            continue;
+        }
+        Cell head = nextHeads[snake];
+        if (eats[snake]) {
+            scores[snake] += SCORE_PER_FOOD;
+            food.remove(head);
+        }
+        owners[index(head)] = static_cast<uint16_t>(snake + 1);
+        occupied.set(head);
+        bodies[snake].pushFront(directions[snake]);
+    }
+
+    while (food.size() < foodCount && occupied.getFreeCount() > 0) {
+        placeFood();
+    }
+    if (respawn) {
+        for (size_t snake = 0; snake < snakes; ++snake) {
+            if (!alive[snake]) {
+                spawn(snake);
+            }
+        }
+    }
+}
+
+size_t Arena::getAliveCount() const {
+    size_t count = 0;
+    for (uint8_t a : alive) {
+        count += a;
+    }
+    return count;
+}
+
+Direction Arena::towardNearestFood(size_t snake) const {
+    Direction current = directions[snake];
+    if (!alive[snake]) {
+        return current;
+    }
+    Cell head = bodies[snake].front();
+    Cell target = food.nearest(head);
+    Direction preferred[4] = {target.x > head.x ? RIGHT : LEFT, target.y > head.y ? DOWN : UP, current, UP};
+    if (target.x == head.x) {
+        preferred[0] = preferred[1];
+    } else if (target.y == head.y) {
+        preferred[1] = preferred[0];
+    }
+    for (Direction direction : preferred) {
+        if (applyTurn(current, direction) == direction && isFree(moveCell(head, direction))) {
+            return direction;
+        }
+    }
+    for (Direction direction : {UP, DOWN, LEFT, RIGHT}) {
+        if (applyTurn(current, direction) == direction && isFree(moveCell(head, direction))) {
+            return direction;
+        }
+    }
+    return current;
+}
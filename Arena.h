@@ -0,0 +1,70 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Cell.h"
+#include "FoodIndex.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+#include "Rules.h"
+#include "SnakeBody.h"
+
+// Daug gyvačių vienoje lentoje. Visos gyvatės dalijasi vienu langelių tinkleliu, kuriame
+// įrašyta, kuriai gyvatei langelis priklauso, todėl susidūrimai su kūnais ir galva į galvą
+// išsprendžiami vienu perėjimu per galvas, nelyginant kiekvienos gyvatės su kiekviena.
+class Arena {
+private:
+    int width;
+    int height;
+    std::vector<uint16_t> owners; // 0 - laisvas langelis, kitaip gyvatės numeris + 1
+    OccupancyGrid occupied; // gyvatės ir maistas; iš jo renkami laisvi langeliai
+    FoodIndex food;
+    size_t foodCount; // kiek maisto vienetų visada laikoma lentoje
+    std::vector<SnakeBody> bodies;
+    std::vector<Direction> directions;
+    std::vector<int> pendingGrowth;
+    std::vector<int> scores;
+    std::vector<uint8_t> alive;
+    // Vieno žingsnio darbiniai masyvai
+    std::vector<Cell> nextHeads;
+    std::vector<uint8_t> eats;
+    std::vector<uint8_t> dying;
+    // Kuri gyvatė šiame žingsnyje pirmoji užėmė langelį galva; galioja tik kai claimTicks == tick
+    std::vector<uint32_t> claimTicks;
+    std::vector<uint16_t> claimOwners;
+    uint32_t tick;
+    Random random;
+    bool respawn;
+    size_t index(Cell cell) const { return static_cast<size_t>(cell.y) * width + cell.x; }
+    void spawn(size_t snake);
+    void kill(size_t snake);
+    void placeFood();
+public:
+    // Gyvačių gali būti iki 65535
+    Arena(int width, int height, size_t snakes, size_t foodCount, uint64_t seed = 0);
+    void reset();
+    // Vienas žingsnis visoms gyvatėms; actions - po vieną kryptį kiekvienai gyvatei
+    void step(const Direction* actions);
+    // Ar žuvusios gyvatės iš karto atgimsta atsitiktiniame laisvame langelyje
+    void setRespawn(bool enabled) { respawn = enabled; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    uint32_t getTick() const { return tick; }
+    size_t getSnakeCount() const { return bodies.size(); }
+    const SnakeBody& getBody(size_t snake) const { return bodies[snake]; }
+    Direction getDirection(size_t snake) const { return directions[snake]; }
+    int getScore(size_t snake) const { return scores[snake]; }
+    bool isAlive(size_t snake) const { return alive[snake] != 0; }
+    size_t getAliveCount() const;
+    const FoodIndex& getFood() const { return food; }
+    bool contains(Cell cell) const { return occupied.contains(cell); }
+    // 0, jei langelis laisvas, kitaip gyvatės numeris + 1
+    uint16_t getOwner(Cell cell) const { return owners[index(cell)]; }
+    bool isFree(Cell cell) const { return contains(cell) && owners[index(cell)] == 0; }
+    // Paprasta strategija: link artimiausio maisto, vengiant sienų ir kūnų
+    Direction towardNearestFood(size_t snake) const;
+};
+
+#endif // ARENA_H
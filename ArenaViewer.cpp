@@ -0,0 +1,118 @@
+#include "ArenaViewer.h"
+#include <ctime>
+#include <iostream>
+
+ArenaViewer::ArenaViewer(size_t snakes, float ticksPerSecond)
+    : window(sf::VideoMode(ArenaBoard::PIXEL_WIDTH, ArenaBoard::PIXEL_HEIGHT), "Snake Arena"),
+      arena(ArenaBoard::WIDTH, ArenaBoard::HEIGHT, snakes, snakes * 2, static_cast<uint64_t>(time(0))),
+      actions(snakes), renderSystem(static_cast<float>(ArenaBoard::CELL_SIZE)),
+      pickingSystem(ArenaBoard::WIDTH, ArenaBoard::HEIGHT), hoverCell{-1, -1},
+      tickDuration(sf::seconds(1.f / ticksPerSecond)), paused(false) {
+    window.setFramerateLimit(60);
+    if (!font.loadFromFile("../resources/arial.ttf")) {
+        std::cerr << "Could not load font!" << std::endl;
+    }
+    statusText.setFont(font);
+    statusText.setCharacterSize(18);
+    statusText.setFillColor(sf::Color::White);
+    statusText.setPosition(10, 10);
+
+    // Spread the hues so neighbouring ids do not get similar colours
+    Random random(snakes);
+    for (size_t snake = 0; snake < snakes; ++snake) {
+        colors.push_back(Renderable{static_cast<uint8_t>(64 + random.below(192)),
+                                    static_cast<uint8_t>(64 + random.below(192)),
+                                    static_cast<uint8_t>(64 + random.below(192)), 255});
+    }
+    rebuildRenderCache();
+}
+
+void ArenaViewer::run() {
+    sf::Clock clock;
+    sf::Time accumulator = sf::Time::Zero;
+    while (window.isOpen()) {
+        handleEvents();
+        accumulator += clock.restart();
+        while (accumulator >= tickDuration) {
+            if (!paused) {
+                update();
+            }
+            accumulator -= tickDuration;
+        }
+        render();
+    }
+}
+
+void ArenaViewer::handleEvents() {
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        } else if (event.type == sf::Event::KeyPressed) {
+            switch (event.key.code) {
+                case sf::Keyboard::Space: paused = !paused; break;
+                case sf::Keyboard::R:
+                    arena.reset();
+                    rebuildRenderCache();
+                    break;
+                case sf::Keyboard::Q: window.close(); break;
+                default: break;
+            }
+        } else if (event.type == sf::Event::MouseMoved) {
+            hoverCell = Cell{event.mouseMove.x / ArenaBoard::CELL_SIZE, event.mouseMove.y / ArenaBoard::CELL_SIZE};
+        }
+    }
+}
+
+void ArenaViewer::update() {
+    for (size_t snake = 0; snake < arena.getSnakeCount(); ++snake) {
+        actions[snake] = arena.towardNearestFood(snake);
+    }
+    arena.step(actions.data());
+    rebuildRenderCache();
+}
+
+void ArenaViewer::rebuildRenderCache() {
+    // The arena owns the game state and resolves its own collisions; the store is only what the
+    // render and picking systems scan. Hundreds of snakes change every tick, so it is refilled
+    // rather than patched; clear() keeps the capacity and recycles the ids, so this does not allocate
+    entities.clear();
+    const FoodIndex& food = arena.getFood();
+    for (size_t i = 0; i < food.size(); ++i) {
+        EntityId entity = entities.create(food[i]);
+        entities.setRenderable(entity, Renderable{255, 0, 0, 255});
+        entities.setPickable(entity, Pickable{PICKABLE_FOOD, 0});
+    }
+    for (size_t snake = 0; snake < arena.getSnakeCount(); ++snake) {
+        Pickable pickable{PICKABLE_BODY, static_cast<uint16_t>(snake + 1)};
+        for (Cell cell : arena.getBody(snake)) {
+            EntityId entity = entities.create(cell);
+            entities.setRenderable(entity, colors[snake]);
+            entities.setPickable(entity, pickable);
+        }
+    }
+    renderSystem.update(entities);
+    pickingSystem.update(entities);
+}
+
+void ArenaViewer::render() {
+    int best = 0;
+    for (size_t snake = 0; snake < arena.getSnakeCount(); ++snake) {
+        if (arena.getScore(snake) > best) {
+            best = arena.getScore(snake);
+        }
+    }
+    std::string status = "Snakes " + std::to_string(arena.getAliveCount()) + "  Tick " +
+                         std::to_string(arena.getTick()) + "  Best " + std::to_string(best);
+    EntityId hovered = pickingSystem.at(hoverCell);
+    if (hovered != NO_ENTITY && entities.getPickable(hovered).kind == PICKABLE_BODY) {
+        size_t snake = entities.getPickable(hovered).owner - 1u;
+        status += "  Snake " + std::to_string(snake) + ": " + std::to_string(arena.getScore(snake));
+    }
+
+    window.clear();
+    renderSystem.draw(window);
+    statusText.setString(status);
+    window.draw(statusText);
+    window.display();
+}
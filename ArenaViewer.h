@@ -0,0 +1,38 @@
+#ifndef ARENAVIEWER_H
+#define ARENAVIEWER_H
+
+#include <SFML/Graphics.hpp>
+#include <vector>
+#include "Arena.h"
+#include "Board.h"
+#include "EntityStore.h"
+#include "PickingSystem.h"
+#include "RenderSystem.h"
+
+// Arenos režimas: daug gyvačių, kurias vairuoja paprasta strategija, vienoje lentoje
+class ArenaViewer {
+private:
+    sf::RenderWindow window;
+    Arena arena;
+    std::vector<Direction> actions;
+    std::vector<Renderable> colors; // kiekvienos gyvatės spalva
+    // Piešimo talpykla: po kiekvieno žingsnio iš naujo užpildoma iš arenos, kuri lieka tikroji būsena.
+    // Kiekvienas maistas ir kūno segmentas - atskiras subjektas
+    EntityStore entities;
+    RenderSystem renderSystem;
+    PickingSystem pickingSystem; // kas po pele; arenos susidūrimai tikrinami Arena viduje
+    Cell hoverCell; // langelis po pele
+    sf::Time tickDuration;
+    bool paused;
+    sf::Font font;
+    sf::Text statusText;
+    void handleEvents();
+    void update();
+    void rebuildRenderCache();
+    void render();
+public:
+    explicit ArenaViewer(size_t snakes, float ticksPerSecond = 15.f);
+    void run();
+};
+
+#endif // ARENAVIEWER_H
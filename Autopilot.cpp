@@ -0,0 +1,241 @@
+#include "Autopilot.h"
+#include <algorithm>
+#include <cstdlib>
+
+Autopilot::Autopilot(int width, int height)
+    : width(width), height(height), stride(width + 2), valid(false), trackedFood{-1, -1}, trackedHead{-1, -1},
+      trackedTail{-1, -1}, trackedLength(0) {
+    size_t cells = static_cast<size_t>(width + 2) * (height + 2);
+    field.assign(cells, WALL);
+    queue.reserve(cells);
+    changed.reserve(cells);
+    seeds.reserve(cells);
+    offsets[UP] = -stride;
+    offsets[DOWN] = stride;
+    offsets[LEFT] = -1;
+    offsets[RIGHT] = 1;
+}
+
+void Autopilot::invalidate() {
+    valid = false;
+}
+
+uint32_t Autopilot::getDistance(Cell cell) const {
+    if (!onBoard(cell)) {
+        return UNREACHABLE;
+    }
+    uint32_t value = field[toIndex(cell)];
+    return value == WALL || value == UNREACHABLE ? UNREACHABLE : value - 1;
+}
+
+Direction Autopilot::decide(const Simulation& simulation) {
+    Direction current = simulation.getDirection();
+    if (simulation.isGameOver()) {
+        valid = false;
+        return current;
+    }
+    sync(simulation);
+
+    // Downhill in the distance field; a free but unreachable cell still beats a wall
+    uint32_t head = toIndex(simulation.getHead());
+    Direction best = current;
+    uint32_t bestValue = WALL;
+    for (int k = 0; k < 4; ++k) {
+        Direction direction = static_cast<Direction>(k);
+        uint32_t value = field[head + offsets[k]];
+        if (applyTurn(current, direction) != direction || value == WALL) {
+            continue;
+        }
+        if (bestValue == WALL || value < bestValue) {
+            best = direction;
+            bestValue = value;
+        }
+    }
+    return best;
+}
+
+void Autopilot::track(const Simulation& simulation) {
+    const SnakeBody& body = simulation.getBody();
+    trackedFood = simulation.getFood();
+    trackedHead = body.front();
+    trackedTail = body.back();
+    trackedLength = body.size();
+    valid = true;
+}
+
+static int manhattan(Cell a, Cell b) {
+    return std::abs(a.x - b.x) + std::abs(a.y - b.y);
+}
+
+void Autopilot::sync(const Simulation& simulation) {
+    if (!valid) {
+        rebuild(simulation);
+        return;
+    }
+    const SnakeBody& body = simulation.getBody();
+    Cell head = body.front();
+    bool foodMoved = simulation.getFood() != trackedFood;
+    if (head != trackedHead || body.size() != trackedLength) {
+        // Only a single step since the last call can be patched: the head moved to a neighbour,
+        // and the tail either stayed (growth) or moved to a neighbour as well
+        bool popped = body.size() == trackedLength;
+        bool grew = body.size() == trackedLength + 1;
+        bool tailFollows = popped ? manhattan(body.back(), trackedTail) == 1 : body.back() == trackedTail;
+        if (manhattan(head, trackedHead) != 1 || !(popped || grew) || !tailFollows) {
+            rebuild(simulation);
+            return;
+        }
+        // Chasing the tail leaves the set of body cells unchanged
+        if (!(popped && head == trackedTail)) {
+            if (foodMoved) {
+                // Every distance is recomputed below, so only the walls need to be right
+                field[toIndex(head)] = WALL;
+                if (popped) {
+                    field[toIndex(trackedTail)] = UNREACHABLE;
+                }
+            } else {
+                blockCell(toIndex(head));
+                if (popped) {
+                    freeCell(toIndex(trackedTail));
+                }
+            }
+        }
+    }
+    if (foodMoved) {
+        computeDistances(simulation.getFood());
+    }
+    track(simulation);
+}
+
+void Autopilot::rebuild(const Simulation& simulation) {
+    std::fill(field.begin(), field.end(), WALL);
+    for (int y = 0; y < height; ++y) {
+        std::fill_n(field.begin() + toIndex(Cell{0, y}), width, UNREACHABLE);
+    }
+    for (Cell cell : simulation.getBody()) {
+        if (onBoard(cell)) {
+            field[toIndex(cell)] = WALL;
+        }
+    }
+    computeDistances(simulation.getFood());
+    track(simulation);
+}
+
+void Autopilot::computeDistances(Cell food) {
+    for (uint32_t& value : field) {
+        value = value == WALL ? WALL : UNREACHABLE;
+    }
+    if (onBoard(food)) {
+        field[toIndex(food)] = 1;
+        queue.push_back(toIndex(food));
+        propagate();
+    }
+}
+
+void Autopilot::propagate() {
+    // Walls hold 0, so a single comparison skips them as well as cells that are already closer
+    for (size_t i = 0; i < queue.size(); ++i) {
+        uint32_t cell = queue[i];
+        uint32_t next = field[cell] + 1;
+        for (int k = 0; k < 4; ++k) {
+            uint32_t neighbour = cell + offsets[k];
+            if (field[neighbour] > next) {
+                field[neighbour] = next;
+                queue.push_back(neighbour);
+            }
+        }
+    }
+    queue.clear();
+}
+
+// Smallest neighbour value plus one, or UNREACHABLE when no neighbour has a path
+static uint32_t bestThroughNeighbours(const std::vector<uint32_t>& field, uint32_t cell, const int* offsets) {
+    uint32_t best = Autopilot::UNREACHABLE;
+    for (int k = 0; k < 4; ++k) {
+        // Walls wrap around to the largest value, and UNREACHABLE - 1 is still too large to win
+        uint32_t value = field[cell + offsets[k]] - 1;
+        best = std::min(best, value);
+    }
+    return best >= Autopilot::UNREACHABLE - 1 ? Autopilot::UNREACHABLE : best + 2;
+}
+
+void Autopilot::freeCell(uint32_t cell) {
+    // A new free cell can only shorten paths, so a BFS from it fixes everything it touches
+    uint32_t value = bestThroughNeighbours(field, cell, offsets);
+    field[cell] = value;
+    if (value != UNREACHABLE) {
+        queue.push_back(cell);
+        propagate();
+    }
+}
+
+void Autopilot::blockCell(uint32_t cell) {
+    uint32_t old = field[cell];
+    field[cell] = WALL;
+    if (old == UNREACHABLE) {
+        return;
+    }
+
+    // Collect the cells whose every shortest path ran through the blocked cell. They are
+    // visited in order of distance, so all affected cells one step closer are already
+    // unreachable when a cell's remaining neighbours are checked.
+    changed.clear();
+    changed.emplace_back(cell, old);
+    for (size_t i = 0; i < changed.size(); ++i) {
+        uint32_t parent = changed[i].first;
+        uint32_t d = changed[i].second;
+        for (int k = 0; k < 4; ++k) {
+            uint32_t child = parent + offsets[k];
+            if (field[child] != d + 1) {
+                continue;
+            }
+            bool supported = false;
+            for (int j = 0; j < 4 && !supported; ++j) {
+                supported = field[child + offsets[j]] == d;
+            }
+            if (!supported) {
+                field[child] = UNREACHABLE;
+                changed.emplace_back(child, d + 1);
+            }
+        }
+    }
+
+    // Each affected cell restarts from its best unaffected neighbour; seeds and the BFS queue
+    // are merged in order of distance, so every cell is settled at its final distance
+    seeds.clear();
+    for (size_t i = 1; i < changed.size(); ++i) {
+        uint32_t c = changed[i].first;
+        uint32_t value = bestThroughNeighbours(field, c, offsets);
+        if (value != UNREACHABLE) {
+            seeds.emplace_back(value, c);
+        }
+    }
+    std::sort(seeds.begin(), seeds.end());
+
+    size_t next = 0;
+    size_t seed = 0;
+    while (true) {
+        uint32_t current;
+        if (next < queue.size() && (seed == seeds.size() || field[queue[next]] <= seeds[seed].first)) {
+            current = queue[next++];
+        } else if (seed < seeds.size()) {
+            uint32_t value = seeds[seed].first;
+            current = seeds[seed++].second;
+            if (value >= field[current]) {
+                continue;
+            }
+            field[current] = value;
+        } else {
+            break;
+        }
+        uint32_t d = field[current] + 1;
+        for (int k = 0; k < 4; ++k) {
+            uint32_t neighbour = current + offsets[k];
+            if (field[neighbour] > d) {
+                field[neighbour] = d;
+                queue.push_back(neighbour);
+            }
+        }
+    }
+    queue.clear();
+}
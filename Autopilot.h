@@ -0,0 +1,56 @@
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Board.h"
+#include "Cell.h"
+#include "Rules.h"
+#include "Simulation.h"
+
+// Automatinis vairuotojas: eina trumpiausiu keliu iki maisto pagal atstumų lauką.
+// Laukas perskaičiuojamas visas tik pasikeitus maistui; kitaip kiekvieną žingsnį
+// pataisoma tik ta dalis, kurią paveikė galvos užimtas ir uodegos atlaisvintas langelis.
+// decide() reikia kviesti kiekvieną žingsnį; praleidus žingsnius reikia kviesti invalidate().
+class Autopilot {
+private:
+    int width;
+    int height;
+    int stride; // eilutės ilgis su rėmeliu
+    // Lenta su vieno langelio rėmeliu aplinkui, kad kaimynams nereikėtų ribų tikrinimo.
+    // Laikomas atstumas + 1, o 0 reiškia sieną arba kūną, todėl BFS tikrina tik vieną sąlygą.
+    static constexpr uint32_t WALL = 0;
+    std::vector<uint32_t> field;
+    std::vector<uint32_t> queue;
+    std::vector<std::pair<uint32_t, uint32_t>> changed; // (langelis, senas atstumas)
+    std::vector<std::pair<uint32_t, uint32_t>> seeds; // (atstumas, langelis)
+    int offsets[4]; // UP, DOWN, LEFT, RIGHT
+    bool valid;
+    Cell trackedFood;
+    Cell trackedHead;
+    Cell trackedTail;
+    size_t trackedLength;
+    uint32_t toIndex(Cell cell) const { return static_cast<uint32_t>((cell.y + 1) * stride + cell.x + 1); }
+    bool onBoard(Cell cell) const { return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height; }
+    void sync(const Simulation& simulation);
+    void rebuild(const Simulation& simulation);
+    void computeDistances(Cell food); // pilnas BFS nuo maisto
+    void blockCell(uint32_t cell);
+    void freeCell(uint32_t cell);
+    void propagate(); // BFS iš queue, mažinant atstumus
+    void track(const Simulation& simulation);
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    explicit Autopilot(int width = GameBoard::WIDTH, int height = GameBoard::HEIGHT);
+    // Kryptis kitam žingsniui; jei maistas nepasiekiamas, renkamasi bet kuri laisva kryptis
+    Direction decide(const Simulation& simulation);
+    // Kitas decide() perskaičiuos visą lauką
+    void invalidate();
+    // Atstumas nuo langelio iki maisto pagal paskutinį decide()
+    uint32_t getDistance(Cell cell) const;
+};
+
+#endif // AUTOPILOT_H
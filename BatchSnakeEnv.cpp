@@ -0,0 +1,167 @@
+#include "BatchSnakeEnv.h"
+#include <algorithm>
+#include "FreeCellIndex.h"
+
+static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+BatchSnakeEnv::BatchSnakeEnv(size_t count, int width, int height, uint64_t seed)
+    : count(count), width(width), height(height), cellCount(static_cast<size_t>(width) * height),
+      bodyCapacity(roundUpToPowerOfTwo(cellCount + 1)), wordsPerGame((cellCount + 63) / 64),
+      autoReset(false), headX(count), headY(count), directions(count), lengths(count), bodyHeads(count), pendingGrowth(count),
+      scores(count), foodX(count), foodY(count), ate(count), done(count), won(count), freeCounts(count),
+      randomKeys(count), randomCounters(count),
+      bodies(count * bodyCapacity), occupied(count * wordsPerGame),
+      freeTrees(count * (wordsPerGame + 1)), nextX(count), nextY(count) {
+    for (size_t game = 0; game < count; ++game) {
+        setRandomState(game, Random(seed, game).getState());
+    }
+    reset();
+}
+
+void BatchSnakeEnv::reset() {
+    for (size_t game = 0; game < count; ++game) {
+        reset(game);
+    }
+}
+
+void BatchSnakeEnv::reset(size_t game) {
+    std::fill_n(occupied.begin() + game * wordsPerGame, wordsPerGame, 0);
+    buildFreeTree(&freeTrees[game * (wordsPerGame + 1)], &occupied[game * wordsPerGame], wordsPerGame, cellCount);
+    freeCounts[game] = static_cast<uint32_t>(cellCount);
+
+    headX[game] = width / 2;
+    headY[game] = height / 2;
+    uint32_t start = static_cast<uint32_t>(headY[game] * width + headX[game]);
+    bodyHeads[game] = 0;
+    bodies[game * bodyCapacity] = start;
+    lengths[game] = 1;
+    occupy(game, start);
+
+    directions[game] = RIGHT;
+    pendingGrowth[game] = 0;
+    scores[game] = 0;
+    ate[game] = 0;
+    done[game] = 0;
+    won[game] = 0;
+    regenerateFood(game);
+}
+
+void BatchSnakeEnv::step(const Direction* actions) {
+    step(actions, 0, count);
+}
+
+void BatchSnakeEnv::step(const Direction* actions, size_t begin, size_t end) {
+    if (autoReset) {
+        // Finished games stay readable until the next step, then start a new episode
+        for (size_t game = begin; game < end; ++game) {
+            if (done[game]) {
+                reset(game);
+            }
+        }
+    }
+
+    // Pass 1: turns and new head positions. Plain arithmetic over the arrays, so the compiler can vectorize it.
+    for (size_t game = begin; game < end; ++game) {
+        Direction current = static_cast<Direction>(directions[game]);
+        Direction turned = applyTurn(current, actions[game]);
+        Direction next = done[game] ? current : turned;
+        directions[game] = static_cast<uint8_t>(next);
+        nextX[game] = headX[game] + directionDx(next);
+        nextY[game] = headY[game] + directionDy(next);
+    }
+
+    // Pass 2: the same per-tick rules as Simulation::step, against each game's body and occupancy
+    uint32_t mask = static_cast<uint32_t>(bodyCapacity - 1);
+    for (size_t game = begin; game < end; ++game) {
+        ate[game] = 0;
+        if (done[game]) {
+            continue;
+        }
+        int32_t x = nextX[game];
+        int32_t y = nextY[game];
+        uint32_t* body = &bodies[game * bodyCapacity];
+
+        if (x == foodX[game] && y == foodY[game]) {
+            pendingGrowth[game] += GROWTH_PER_FOOD;
+            scores[game] += SCORE_PER_FOOD;
+            ate[game] = 1;
+        }
+
+        // The tail is released before the collision check, so the head may enter the cell it frees
+        if (pendingGrowth[game] > 0) {
+            --pendingGrowth[game];
+        } else {
+            release(game, body[(bodyHeads[game] + lengths[game] - 1) & mask]);
+            --lengths[game];
+        }
+
+        headX[game] = x;
+        headY[game] = y;
+        if (x < 0 || y < 0 || x >= width || y >= height) {
+            done[game] = 1;
+            continue;
+        }
+        uint32_t cell = static_cast<uint32_t>(y * width + x);
+        if (isOccupied(game, cell)) {
+            done[game] = 1;
+            continue;
+        }
+        occupy(game, cell);
+        bodyHeads[game] = (bodyHeads[game] - 1) & mask;
+        body[bodyHeads[game]] = cell;
+        ++lengths[game];
+
+        if (ate[game]) {
+            regenerateFood(game);
+        }
+    }
+}
+
+void BatchSnakeEnv::setRandomState(size_t game, Random::State state) {
+    randomKeys[game] = state.key;
+    randomCounters[game] = state.counter;
+}
+
+Cell BatchSnakeEnv::getSegment(size_t game, size_t i) const {
+    uint32_t cell = bodies[game * bodyCapacity + ((bodyHeads[game] + i) & (bodyCapacity - 1))];
+    return Cell{static_cast<int>(cell % width), static_cast<int>(cell / width)};
+}
+
+bool BatchSnakeEnv::isOccupied(size_t game, uint32_t cell) const {
+    return (occupied[game * wordsPerGame + (cell >> 6)] >> (cell & 63)) & 1u;
+}
+
+void BatchSnakeEnv::occupy(size_t game, uint32_t cell) {
+    occupied[game * wordsPerGame + (cell >> 6)] |= uint64_t(1) << (cell & 63);
+    addFree(&freeTrees[game * (wordsPerGame + 1)], wordsPerGame, cell >> 6, -1);
+    --freeCounts[game];
+}
+
+void BatchSnakeEnv::release(size_t game, uint32_t cell) {
+    occupied[game * wordsPerGame + (cell >> 6)] &= ~(uint64_t(1) << (cell & 63));
+    addFree(&freeTrees[game * (wordsPerGame + 1)], wordsPerGame, cell >> 6, 1);
+    ++freeCounts[game];
+}
+
+void BatchSnakeEnv::regenerateFood(size_t game) {
+    if (freeCounts[game] == 0) {
+        foodX[game] = -1;
+        foodY[game] = -1;
+        won[game] = 1;
+        done[game] = 1;
+        return;
+    }
+    Random random;
+    random.setState(getRandomState(game));
+    uint32_t cell = static_cast<uint32_t>(selectFree(&freeTrees[game * (wordsPerGame + 1)], &occupied[game * wordsPerGame],
+                                                     wordsPerGame, cellCount, random.below(freeCounts[game])));
+    randomCounters[game] = random.getState().counter;
+    foodX[game] = static_cast<int32_t>(cell % width);
+    foodY[game] = static_cast<int32_t>(cell / width);
+}
@@ -0,0 +1,84 @@
+#ifndef BATCHSNAKEENV_H
+#define BATCHSNAKEENV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+#include "Cell.h"
+#include "Random.h"
+#include "Rules.h"
+
+// N nepriklausomų žaidimų, laikomų masyvų struktūroje (structure of arrays).
+// Vieno žaidimo duomenys nėra atskiras objektas: kiekvienas laukas yra ištisinis N elementų masyvas,
+// todėl step() eina per visus žaidimus tiesiniais ciklais be virtualių kvietimų.
+class BatchSnakeEnv {
+private:
+    size_t count;
+    int width;
+    int height;
+    size_t cellCount; // width * height
+    size_t bodyCapacity; // vieno žaidimo kūno buferio dydis, dvejeto laipsnis
+    size_t wordsPerGame; // užimtumo bitų lauko dydis 64 bitų žodžiais
+    bool autoReset;
+
+    // Po vieną elementą kiekvienam žaidimui
+    std::vector<int32_t> headX;
+    std::vector<int32_t> headY;
+    std::vector<uint8_t> directions;
+    std::vector<uint32_t> lengths;
+    std::vector<uint32_t> bodyHeads; // galvos vieta žaidimo kūno buferyje
+    std::vector<int32_t> pendingGrowth;
+    std::vector<int32_t> scores;
+    std::vector<int32_t> foodX;
+    std::vector<int32_t> foodY;
+    std::vector<uint8_t> ate;
+    std::vector<uint8_t> done;
+    std::vector<uint8_t> won;
+    std::vector<uint32_t> freeCounts;
+    std::vector<uint64_t> randomKeys; // kiekvieno žaidimo atsitiktinių skaičių srautas
+    std::vector<uint64_t> randomCounters;
+
+    // Po bodyCapacity, wordsPerGame ar wordsPerGame + 1 elementų kiekvienam žaidimui, vienas po kito
+    std::vector<uint32_t> bodies; // langelių indeksai y * width + x
+    std::vector<uint64_t> occupied;
+    std::vector<uint32_t> freeTrees; // laisvų langelių rodyklė (FreeCellIndex.h), wordsPerGame + 1 elementų
+
+    // Naujos galvos pozicijos, apskaičiuojamos pirmame step() etape
+    std::vector<int32_t> nextX;
+    std::vector<int32_t> nextY;
+
+    bool isOccupied(size_t game, uint32_t cell) const;
+    void occupy(size_t game, uint32_t cell);
+    void release(size_t game, uint32_t cell);
+    void regenerateFood(size_t game);
+public:
+    // Žaidimas game gauna srautą Random(seed, game), todėl rezultatas nepriklauso nuo gijų skaičiaus
+    BatchSnakeEnv(size_t count, int width = GameBoard::WIDTH, int height = GameBoard::HEIGHT,
+                  uint64_t seed = 0);
+    void reset();
+    void reset(size_t game);
+    // Vienas žingsnis visiems žaidimams; actions turi size() elementų. Baigti žaidimai nekeičiami.
+    void step(const Direction* actions);
+    // Žingsnis tik žaidimams [begin, end); skirtingus intervalus galima vykdyti lygiagrečiai
+    void step(const Direction* actions, size_t begin, size_t end);
+    // Jei įjungta, žaidimas, pasibaigęs ankstesniame žingsnyje, perkraunamas prieš kitą žingsnį
+    void setAutoReset(bool enabled) { autoReset = enabled; }
+    size_t size() const { return count; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    Cell getHead(size_t game) const { return Cell{headX[game], headY[game]}; }
+    Cell getFood(size_t game) const { return Cell{foodX[game], foodY[game]}; }
+    Direction getDirection(size_t game) const { return static_cast<Direction>(directions[game]); }
+    size_t getLength(size_t game) const { return lengths[game]; }
+    // i-tasis kūno segmentas nuo galvos
+    Cell getSegment(size_t game, size_t i) const;
+    int getScore(size_t game) const { return scores[game]; }
+    bool ateFood(size_t game) const { return ate[game] != 0; }
+    bool isGameOver(size_t game) const { return done[game] != 0; }
+    bool isWon(size_t game) const { return won[game] != 0; }
+    Random::State getRandomState(size_t game) const { return Random::State{randomKeys[game], randomCounters[game]}; }
+    void setRandomState(size_t game, Random::State state);
+};
+
+#endif // BATCHSNAKEENV_H
@@ -0,0 +1,481 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "AllocationCounter.h"
+#include "Arena.h"
+#include "Autopilot.h"
+#include "BatchSnakeEnv.h"
+#include "EntityStore.h"
+#include "FrameProfiler.h"
+#include "HamiltonianController.h"
+#include "HamiltonianCycle.h"
+#include "MctsController.h"
+#include "OccupancyGrid.h"
+#include "ParallelRunner.h"
+#include "PickingSystem.h"
+#include "Random.h"
+#include "Simulation.h"
+#include "Tracer.h"
+#include "TranspositionTable.h"
+
+// Mikrotestai simuliacijos karštiems keliams: ns/op ir atminties išskyrimai/op
+
+static volatile uint64_t sink;
+
+using Clock = std::chrono::steady_clock;
+
+// Timed section totals: time and allocations are summed only while a section is open
+struct Measurement {
+    double nanoseconds = 0;
+    uint64_t allocations = 0;
+    uint64_t operations = 0;
+    Clock::time_point started;
+    uint64_t allocationsAtStart = 0;
+
+    void begin() {
+        allocationsAtStart = getAllocationCount();
+        started = Clock::now();
+    }
+    void end(uint64_t ops) {
+        nanoseconds += std::chrono::duration<double, std::nano>(Clock::now() - started).count();
+        allocations += getAllocationCount() - allocationsAtStart;
+        operations += ops;
+    }
+    void report(const char* name, int width, int height, size_t length) const {
+        char board[32];
+        std::snprintf(board, sizeof(board), "%4dx%-4d len %-7zu", width, height, length);
+        report(name, board);
+    }
+    // For rows that measure no board; detail fills the board column
+    void report(const char* name, const char* detail = "") const {
+        std::printf("%-24s %-21s %9.2f ns/op %8.4f allocs/op\n", name, detail,
+                    nanoseconds / operations, static_cast<double>(allocations) / operations);
+    }
+};
+
+// A snake of the given length lying along the cycle, so it can keep moving without dying
+static SimulationState snakeOnCycle(const Simulation& simulation, size_t length) {
+    std::shared_ptr<const HamiltonianCycle> cycle =
+            HamiltonianCycle::get(simulation.getWidth(), simulation.getHeight());
+    SimulationState state = simulation.getState();
+    state.body.clear();
+    Cell cell{0, 0};
+    for (size_t i = 0; i < length; ++i) {
+        state.body.push_back(cell);
+        cell = moveCell(cell, cycle->getDirection(cell));
+    }
+    // The walk went from the tail to the head
+    std::reverse(state.body.begin(), state.body.end());
+    state.direction = cycle->getDirection(state.body[1]);
+    state.pendingGrowth = 0;
+    // Food out of reach keeps the length fixed while measuring
+    state.food = Cell{-1, -1};
+    return state;
+}
+
+static void benchmarkStep(int size, size_t length) {
+    const int BATCH = 1024;
+    Simulation simulation(size, size, 1);
+    std::shared_ptr<const HamiltonianCycle> cycle = HamiltonianCycle::get(size, size);
+    SimulationState start = snakeOnCycle(simulation, length);
+    Measurement m;
+    for (int round = 0; round < 200; ++round) {
+        simulation.setState(start);
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            simulation.step(cycle->getDirection(simulation.getHead()));
+        }
+        m.end(BATCH);
+    }
+    sink = sink + simulation.getScore();
+    m.report("step (move+collision)", size, size, length);
+}
+
+template <typename BoardT>
+static void benchmarkSnapshot(size_t length) {
+    const int BATCH = 1024;
+    Simulation simulation(BoardT::WIDTH, BoardT::HEIGHT, 1);
+    simulation.setState(snakeOnCycle(simulation, length));
+    Snapshot<BoardT> snapshot;
+    simulation.save(snapshot);
+    Measurement m;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            simulation.save(snapshot);
+            simulation.restore(snapshot);
+        }
+        m.end(BATCH);
+    }
+    sink = sink + simulation.getScore();
+    m.report("snapshot save+restore", BoardT::WIDTH, BoardT::HEIGHT, length);
+}
+
+static void benchmarkOccupancy(int size, size_t length) {
+    const int BATCH = 4096;
+    Simulation simulation(size, size, 1);
+    simulation.setState(snakeOnCycle(simulation, length));
+    Random random(7);
+    std::vector<Cell> probes;
+    for (int i = 0; i < BATCH; ++i) {
+        probes.push_back(Cell{static_cast<int>(random.below(size)), static_cast<int>(random.below(size))});
+    }
+    Measurement m;
+    uint64_t hits = 0;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (const Cell& cell : probes) {
+            hits += simulation.isFree(cell);
+        }
+        m.end(BATCH);
+    }
+    sink = sink + hits;
+    m.report("occupancy test", size, size, length);
+}
+
+static void benchmarkFoodPlacement(int size, size_t length) {
+    const int BATCH = 4096;
+    OccupancyGrid grid(size, size);
+    Simulation simulation(size, size, 1);
+    for (const Cell& cell : snakeOnCycle(simulation, length).body) {
+        grid.set(cell);
+    }
+    Random random(7);
+    Measurement m;
+    uint64_t total = 0;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            Cell food = grid.getFreeCell(random.below(static_cast<uint32_t>(grid.getFreeCount())));
+            total += food.x + food.y;
+        }
+        m.end(BATCH);
+    }
+    sink = sink + total;
+    m.report("food placement", size, size, length);
+}
+
+// Heads for the food, but never into a wall or the body when another move is free
+static Direction greedyDirection(const Simulation& simulation) {
+    Cell head = simulation.getHead();
+    Cell food = simulation.getFood();
+    Direction preferred[4] = {food.x > head.x ? RIGHT : LEFT, food.y > head.y ? DOWN : UP, UP, RIGHT};
+    for (Direction direction : preferred) {
+        if (applyTurn(simulation.getDirection(), direction) == direction &&
+            simulation.isFree(moveCell(head, direction))) {
+            return direction;
+        }
+    }
+    for (Direction direction : {UP, DOWN, LEFT, RIGHT}) {
+        if (simulation.isFree(moveCell(head, direction))) {
+            return direction;
+        }
+    }
+    return simulation.getDirection();
+}
+
+static void benchmarkEpisodes(int size) {
+    Simulation simulation(size, size, 1);
+    Measurement m;
+    uint64_t episodes = 0;
+    m.begin();
+    uint64_t ticks = 0;
+    while (ticks < 5000000) {
+        simulation.step(greedyDirection(simulation));
+        ++ticks;
+        if (simulation.isGameOver()) {
+            simulation.reset();
+            ++episodes;
+        }
+    }
+    m.end(ticks);
+    std::printf("%-24s %4dx%-4d %8.2f Mticks/s (%llu episodes) %8.4f allocs/tick\n", "full episodes", size, size,
+                ticks / m.nanoseconds * 1e3, static_cast<unsigned long long>(episodes),
+                static_cast<double>(m.allocations) / ticks);
+}
+
+// Memory held by a long snake on a large board, which must not depend on the board size
+// Resident set size from /proc, in KB; 0 where it is not available
+static size_t residentKilobytes() {
+    std::FILE* status = std::fopen("/proc/self/status", "r");
+    if (status == nullptr) {
+        return 0;
+    }
+    char line[128];
+    size_t kilobytes = 0;
+    while (std::fgets(line, sizeof(line), status) != nullptr) {
+        if (std::sscanf(line, "VmRSS: %zu kB", &kilobytes) == 1) {
+            break;
+        }
+    }
+    std::fclose(status);
+    return kilobytes;
+}
+
+static void benchmarkLargeBoard(int size, size_t length) {
+    size_t residentBefore = residentKilobytes();
+    Simulation simulation(size, size, 1);
+    std::printf("%-24s %4dx%-4d %9zu KB resident (occupancy, free cell index, hash keys)\n", "simulation memory",
+                size, size, residentKilobytes() - residentBefore);
+    simulation.setState(snakeOnCycle(simulation, length));
+    const SnakeBody& body = simulation.getBody();
+    std::printf("%-24s %4dx%-4d len %-7zu %9.2f bits/segment (%zu KB body)\n", "body memory", size, size, length,
+                body.getMemoryUsage() * 8.0 / body.size(), body.getMemoryUsage() / 1024);
+    benchmarkStep(size, length);
+    benchmarkOccupancy(size, length);
+    benchmarkFoodPlacement(size, length);
+}
+
+// Decisions include the simulation step that follows each one
+static void benchmarkAutopilot(int size) {
+    Simulation simulation(size, size, 1);
+    Autopilot autopilot(size, size);
+    Measurement m;
+    uint64_t episodes = 0;
+    uint64_t score = 0;
+    const uint64_t DECISIONS = 2000000;
+    m.begin();
+    for (uint64_t i = 0; i < DECISIONS; ++i) {
+        simulation.step(autopilot.decide(simulation));
+        if (simulation.isGameOver()) {
+            score += simulation.getScore();
+            simulation.reset();
+            ++episodes;
+        }
+    }
+    m.end(DECISIONS);
+    std::printf("%-24s %4dx%-4d %8.2f Mdecisions/s (avg score %llu) %8.4f allocs/decision\n", "autopilot", size,
+                size, m.operations / m.nanoseconds * 1e3,
+                static_cast<unsigned long long>(episodes ? score / episodes : 0),
+                static_cast<double>(m.allocations) / m.operations);
+}
+
+// Plays whole games to the end, which for this controller means filling the board
+static void benchmarkHamiltonian(int size, int games) {
+    Simulation simulation(size, size, 1);
+    HamiltonianController controller(size, size);
+    Measurement m;
+    uint64_t ticks = 0;
+    uint64_t score = 0;
+    int wins = 0;
+    m.begin();
+    for (int game = 0; game < games; ++ticks) {
+        simulation.step(controller.decide(simulation));
+        if (simulation.isGameOver()) {
+            score += simulation.getScore();
+            wins += simulation.isWon();
+            simulation.reset();
+            ++game;
+        }
+    }
+    m.end(ticks);
+    std::printf("%-24s %4dx%-4d %8.2f Mdecisions/s (%d/%d won, avg score %llu, %llu ticks/game) %8.4f allocs/decision\n",
+                "hamiltonian", size, size, m.operations / m.nanoseconds * 1e3, wins, games,
+                static_cast<unsigned long long>(score / games), static_cast<unsigned long long>(ticks / games),
+                static_cast<double>(m.allocations) / m.operations);
+}
+
+// One phase measured per operation, with the profiler off and on
+static void benchmarkProfiler(bool enabled) {
+    const int BATCH = 4096;
+    FrameProfiler profiler;
+    profiler.setEnabled(enabled);
+    Measurement m;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            uint64_t start = profiler.begin();
+            profiler.end(PHASE_UPDATE, start);
+        }
+        m.end(BATCH);
+    }
+    sink = sink + static_cast<int>(profiler.getPhase(PHASE_UPDATE).getCount());
+    m.report(enabled ? "profiled phase (on)" : "profiled phase (off)");
+}
+
+// What a traced scope costs while no trace is being written
+static void benchmarkTraceScope() {
+    const int BATCH = 4096;
+    Measurement m;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            TraceScope trace("benchmark");
+        }
+        m.end(BATCH);
+    }
+    m.report("trace scope (off)");
+}
+
+static void benchmarkTranspositionTable() {
+    const int BATCH = 4096;
+    TranspositionTable table;
+    Random random(7);
+    Measurement m;
+    uint64_t found = 0;
+    for (int round = 0; round < 200; ++round) {
+        m.begin();
+        for (int i = 0; i < BATCH; ++i) {
+            uint64_t key = random.next();
+            uint64_t data = 0;
+            if (!table.probe(key, data)) {
+                table.store(key, key >> 7);
+            }
+            found += data;
+        }
+        m.end(BATCH);
+    }
+    sink = sink + static_cast<int>(found);
+    char capacity[32];
+    std::snprintf(capacity, sizeof(capacity), "%zu entries", table.getCapacity());
+    m.report("transposition probe", capacity);
+}
+
+static void benchmarkMcts(size_t threads, size_t trees, bool shared) {
+    const int DECISIONS = 100;
+    MctsController<Board30> controller(threads, trees, 2000,
+                                       shared ? std::make_shared<TranspositionTable>() : nullptr);
+    Simulation simulation(Board30::WIDTH, Board30::HEIGHT, 1);
+    int foods = 0;
+    for (int decision = 0; decision < DECISIONS; ++decision) {
+        StepResult result = simulation.step(controller.decide(simulation));
+        foods += result.ateFood;
+        if (result.gameOver) {
+            simulation.reset();
+        }
+    }
+    const MctsStats& stats = controller.getTotalStats();
+    std::printf("%-24s %4dx%-4d %8.0f playouts/s (%zu threads, %zu trees, %llu nodes/decision, %.1f%% cached, "
+                "%d food in %d moves)\n",
+                "mcts", Board30::WIDTH, Board30::HEIGHT, stats.getPlayoutsPerSecond(), controller.getThreadCount(),
+                controller.getTreeCount(), static_cast<unsigned long long>(stats.nodes / DECISIONS),
+                100.0 * stats.cacheHits / stats.playouts, foods, DECISIONS);
+}
+
+static void benchmarkArena(int size, size_t snakes, size_t foods) {
+    Arena arena(size, size, snakes, foods, 1);
+    std::vector<Direction> actions(snakes);
+    EntityStore entities;
+    PickingSystem picking(size, size);
+    Measurement policy;
+    Measurement m;
+    Measurement systems;
+    const int TICKS = 2000;
+    for (int tick = 0; tick < TICKS; ++tick) {
+        policy.begin();
+        for (size_t snake = 0; snake < snakes; ++snake) {
+            actions[snake] = arena.towardNearestFood(snake);
+        }
+        policy.end(snakes);
+        m.begin();
+        arena.step(actions.data());
+        m.end(snakes);
+
+        // The same refill the arena viewer does before drawing
+        systems.begin();
+        entities.clear();
+        for (size_t i = 0; i < arena.getFood().size(); ++i) {
+            EntityId entity = entities.create(arena.getFood()[i]);
+            entities.setPickable(entity, Pickable{PICKABLE_FOOD, 0});
+        }
+        for (size_t snake = 0; snake < snakes; ++snake) {
+            for (Cell cell : arena.getBody(snake)) {
+                EntityId entity = entities.create(cell);
+                entities.setRenderable(entity, Renderable{255, 255, 255, 255});
+                entities.setPickable(entity, Pickable{PICKABLE_BODY, static_cast<uint16_t>(snake + 1)});
+            }
+        }
+        picking.update(entities);
+        systems.end(entities.size());
+    }
+    std::printf("%-24s %4dx%-4d %8.2f Msnake-moves/s (%zu snakes, %zu food) %8.4f allocs/move\n", "arena step", size,
+                size, m.operations / m.nanoseconds * 1e3, snakes, foods,
+                static_cast<double>(m.allocations) / m.operations);
+    std::printf("%-24s %4dx%-4d %9.2f ns/op %8.4f allocs/op\n", "arena nearest food", size, size,
+                policy.nanoseconds / policy.operations, static_cast<double>(policy.allocations) / policy.operations);
+    std::printf("%-24s %4dx%-4d %9.2f ns/entity %8.4f allocs/entity\n", "arena render cache", size, size,
+                systems.nanoseconds / systems.operations, static_cast<double>(systems.allocations) / systems.operations);
+}
+
+static void benchmarkBatch(int size, size_t games) {
+    BatchSnakeEnv env(games, size, size, 1);
+    env.setAutoReset(true);
+    std::vector<Direction> actions(games);
+    Measurement m;
+    const int TICKS = 2000;
+    for (int tick = 0; tick < TICKS; ++tick) {
+        for (size_t game = 0; game < games; ++game) {
+            Cell head = env.getHead(game);
+            Cell food = env.getFood(game);
+            actions[game] = food.x > head.x ? RIGHT : food.x < head.x ? LEFT : food.y > head.y ? DOWN : UP;
+        }
+        m.begin();
+        env.step(actions.data());
+        m.end(games);
+    }
+    std::printf("%-24s %4dx%-4d %8.2f Mticks/s (%zu games)   %8.4f allocs/tick\n", "batch env step", size, size,
+                m.operations / m.nanoseconds * 1e3, games, static_cast<double>(m.allocations) / m.operations);
+}
+
+// Episodes through the thread pool; with enough chunks the rate should grow about linearly with threads
+static void benchmarkParallelRunner(int size, size_t games, size_t threads) {
+    BatchSnakeEnv env(games, size, size, 1);
+    ThreadPool pool(threads);
+    ParallelRunner runner(env, pool, 256);
+    Policy policy = [](const BatchSnakeEnv& batch, size_t game) {
+        Cell head = batch.getHead(game);
+        Cell food = batch.getFood(game);
+        return food.x > head.x ? RIGHT : food.x < head.x ? LEFT : food.y > head.y ? DOWN : UP;
+    };
+    Measurement m;
+    m.begin();
+    RunStats stats = runner.runEpisodes(policy, games * 4);
+    m.end(stats.ticks);
+    std::printf("%-24s %4dx%-4d %8.2f Mticks/s (%zu games, %zu threads, %llu episodes)\n", "parallel runner", size, size,
+                m.operations / m.nanoseconds * 1e3, games, pool.size(), static_cast<unsigned long long>(stats.episodes));
+}
+
+int main() {
+    const int sizes[] = {30, 64, 256};
+    for (int size : sizes) {
+        size_t cells = static_cast<size_t>(size) * size;
+        const size_t lengths[] = {4, 64, cells / 2, cells * 9 / 10};
+        for (size_t length : lengths) {
+            benchmarkStep(size, length);
+        }
+        for (size_t length : lengths) {
+            benchmarkOccupancy(size, length);
+        }
+        for (size_t length : lengths) {
+            benchmarkFoodPlacement(size, length);
+        }
+    }
+    for (int size : sizes) {
+        benchmarkEpisodes(size);
+    }
+    benchmarkSnapshot<Board30>(4);
+    benchmarkSnapshot<Board30>(810);
+    benchmarkSnapshot<Board64>(3686);
+    // Full BFS on every food makes large boards slow to benchmark
+    benchmarkAutopilot(30);
+    benchmarkAutopilot(64);
+    benchmarkHamiltonian(30, 50);
+    benchmarkProfiler(false);
+    benchmarkProfiler(true);
+    benchmarkTraceScope();
+    benchmarkTranspositionTable();
+    benchmarkMcts(1, 1, false);
+    benchmarkMcts(1, 1, true);
+    benchmarkMcts(0, 1, true);
+    benchmarkMcts(0, 4, true);
+    benchmarkLargeBoard(4096, 1000000);
+    benchmarkArena(256, 200, 400);
+    benchmarkBatch(30, 4096);
+    for (size_t threads : {1, 2, 4, 8}) {
+        benchmarkParallelRunner(30, 4096, threads);
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#ifndef BOARD_H
+#define BOARD_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Cell.h"
+
+// Lentos geometrija kompiliavimo metu: W x H langelių po CellPixels taškų.
+// Kai plotis yra dvejeto laipsnis (64, 256, ...), indeksavimas virsta postūmiu ir kauke;
+// ribų tikrinimas visada yra vienas nepažymėtas palyginimas kiekvienai ašiai.
+template <int W, int H, int CellPixels>
+struct Board {
+    static_assert(W > 0 && H > 0 && CellPixels > 0, "Board dimensions must be positive");
+
+    static constexpr int WIDTH = W;
+    static constexpr int HEIGHT = H;
+    static constexpr size_t CELLS = static_cast<size_t>(W) * H;
+    static constexpr int CELL_SIZE = CellPixels;
+    static constexpr int PIXEL_WIDTH = W * CellPixels;
+    static constexpr int PIXEL_HEIGHT = H * CellPixels;
+    static constexpr size_t WORDS = (CELLS + 63) / 64; // užimtumo bitų lauko dydis
+
+    static constexpr bool POWER_OF_TWO_WIDTH = (W & (W - 1)) == 0;
+    static constexpr int WIDTH_SHIFT = [] {
+        int shift = 0;
+        while ((1 << shift) < W) {
+            ++shift;
+        }
+        return shift;
+    }();
+
+    // Užimtumo bitų laukas, kurio dydis žinomas kompiliavimo metu
+    using Occupancy = std::array<uint64_t, WORDS>;
+
+    static constexpr bool contains(Cell cell) {
+        return static_cast<unsigned>(cell.x) < static_cast<unsigned>(W) &&
+               static_cast<unsigned>(cell.y) < static_cast<unsigned>(H);
+    }
+
+    static constexpr size_t index(Cell cell) {
+        if constexpr (POWER_OF_TWO_WIDTH) {
+            return (static_cast<size_t>(cell.y) << WIDTH_SHIFT) | static_cast<size_t>(cell.x);
+        } else {
+            return static_cast<size_t>(cell.y) * W + static_cast<size_t>(cell.x);
+        }
+    }
+
+    // words - bitų laukas eilutėmis, pvz. Occupancy::data() ar Simulation::getOccupancyWords()
+    static bool test(const uint64_t* words, Cell cell) {
+        size_t i = index(cell);
+        return (words[i >> 6] >> (i & 63)) & 1u;
+    }
+
+    // Langelio kairiojo viršutinio kampo koordinatės ekrane
+    static constexpr float pixelX(Cell cell) { return static_cast<float>(cell.x * CellPixels); }
+    static constexpr float pixelY(Cell cell) { return static_cast<float>(cell.y * CellPixels); }
+};
+
+// Dažniausi dydžiai
+using Board30 = Board<30, 30, 20>;
+using Board64 = Board<64, 64, 10>;
+
+// Lenta, kurią naudoja žaidimo langas; pagal ją parenkamas ir lango dydis
+using GameBoard = Board30;
+
+// Lenta daugelio gyvačių arenai
+using ArenaBoard = Board<128, 128, 6>;
+
+#endif // BOARD_H
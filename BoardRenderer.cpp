@@ -0,0 +1,79 @@
+#include "BoardRenderer.h"
+#include "Board.h"
+
+BoardRenderer::BoardRenderer(const Simulation& simulation)
+    : simulation(simulation), vertices(sf::Quads), renderedHead(0), renderedCount(0), renderedCapacity(0),
+      needsRebuild(true) {
+}
+
+void BoardRenderer::invalidate() {
+    needsRebuild = true;
+}
+
+void BoardRenderer::draw(sf::RenderWindow& window) {
+    sync();
+    window.draw(vertices);
+}
+
+void BoardRenderer::sync() {
+    const SnakeBody& body = simulation.getBody();
+    if (needsRebuild || body.getCapacity() != renderedCapacity) {
+        rebuild();
+    } else {
+        size_t mask = renderedCapacity - 1;
+        // The head slot moves backwards through the ring by one per pushed segment
+        size_t pushed = (renderedHead - body.getSlot(0)) & mask;
+        if (renderedCount + pushed < body.size()) {
+            rebuild();
+        } else {
+            // Segments pushed since the last frame are at the front; whatever survived from
+            // the previous frame is the tail end of the body and is already in place
+            size_t added = pushed < body.size() ? pushed : body.size();
+            size_t kept = body.size() - added;
+            for (size_t i = kept; i < renderedCount; ++i) {
+                clearQuad(((renderedHead + i) & mask) + 1);
+            }
+            SnakeBody::const_iterator cell = body.begin();
+            for (size_t i = 0; i < added; ++i, ++cell) {
+                setQuad(body.getSlot(i) + 1, *cell, sf::Color::Green);
+            }
+        }
+    }
+    renderedHead = body.getSlot(0);
+    renderedCount = body.size();
+    setQuad(0, simulation.getFood(), sf::Color::Red);
+}
+
+void BoardRenderer::rebuild() {
+    const SnakeBody& body = simulation.getBody();
+    renderedCapacity = body.getCapacity();
+    vertices.clear();
+    vertices.resize((renderedCapacity + 1) * 4);
+    size_t i = 0;
+    for (Cell cell : body) {
+        setQuad(body.getSlot(i++) + 1, cell, sf::Color::Green);
+    }
+    needsRebuild = false;
+}
+
+void BoardRenderer::setQuad(size_t quad, Cell cell, sf::Color color) {
+    sf::Vertex* v = &vertices[quad * 4];
+    float left = GameBoard::pixelX(cell);
+    float top = GameBoard::pixelY(cell);
+    float size = GameBoard::CELL_SIZE;
+    v[0].position = sf::Vector2f(left, top);
+    v[1].position = sf::Vector2f(left + size, top);
+    v[2].position = sf::Vector2f(left + size, top + size);
+    v[3].position = sf::Vector2f(left, top + size);
+    for (int i = 0; i < 4; ++i) {
+        v[i].color = color;
+    }
+}
+
+void BoardRenderer::clearQuad(size_t quad) {
+    // A quad with all corners in one point covers no pixels
+    sf::Vertex* v = &vertices[quad * 4];
+    for (int i = 0; i < 4; ++i) {
+        v[i].position = sf::Vector2f(0, 0);
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef BOARDRENDERER_H
+#define BOARDRENDERER_H
+
+#include <SFML/Graphics.hpp>
+#include "Simulation.h"
+
+// Piešia visą gyvatę ir maistą vienu window.draw() kvietimu.
+// Keturkampiai laikomi tose pačiose vietose kaip SnakeBody žiediniame buferyje,
+// todėl kiekvieną kadrą atnaujinami tik nauji galvos ir pašalinti uodegos segmentai.
+class BoardRenderer {
+private:
+    const Simulation& simulation;
+    sf::VertexArray vertices; // 0 keturkampis - maistas, toliau - kūno buferio vietos
+    size_t renderedHead; // galvos vieta buferyje paskutinio atnaujinimo metu
+    size_t renderedCount;
+    size_t renderedCapacity;
+    bool needsRebuild;
+    void setQuad(size_t quad, Cell cell, sf::Color color);
+    void clearQuad(size_t quad);
+    void rebuild();
+    void sync();
+public:
+    explicit BoardRenderer(const Simulation& simulation);
+    // pažymi, kad simuliacija pakeista ne žingsniu (pvz. perkrauta) ir masyvą reikia perstatyti
+    void invalidate();
+    void draw(sf::RenderWindow& window);
+};
+
+#endif // BOARDRENDERER_H
@@ -0,0 +1,18 @@
+#ifndef CELL_H
+#define CELL_H
+
+// Langelio koordinatės žaidimo lentoje
+struct Cell {
+    int x;
+    int y;
+};
+
+inline bool operator==(const Cell& a, const Cell& b) {
+    return a.x == b.x && a.y == b.y;
+}
+
+inline bool operator!=(const Cell& a, const Cell& b) {
+    return !(a == b);
+}
+
+#endif // CELL_H
@@ -1,18 +1,98 @@
 #ifndef CONTAINER_H
 #define CONTAINER_H
 
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Rankena į Container elementą. Kai elementas pašalinamas, jo vietos karta padidėja,
+// todėl sena rankena nebetinka ir nerodo į naują elementą toje pačioje vietoje
+struct Handle {
+    uint32_t index;
+    uint32_t generation;
+
+    bool operator==(const Handle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Handle& other) const { return !(*this == other); }
+};
+
+const Handle NO_HANDLE = {UINT32_MAX, 0};
+
+// Rankenų lentelė mažoms reikšmėms (EntityStore joje laiko subjekto vietą tankiuose masyvuose).
+// Elementai pasiekiami rankenomis per nuorodą, be kopijų; atlaisvintos vietos grąžinamos į sąrašą
+// ir naudojamos vėl, todėl pastovaus dydžio naudojimas krūvos neliečia. Vietos laikomos viename
+// vektoriuje, tad augant nuorodos į elementus gali nebegalioti - rankenos galioja visada.
 template <typename T>
 class Container {
-    T element;
+private:
+    static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+    struct Slot {
+        T value;
+        uint32_t generation; // nelyginė - vieta užimta
+        uint32_t nextFree;
+    };
+
+    std::vector<Slot> slots;
+    uint32_t count;
+    uint32_t freeHead; // pirma laisva vieta arba NO_SLOT
+
+    bool valid(Handle handle) const {
+        return handle.index < slots.size() && (handle.generation & 1u) &&
+               slots[handle.index].generation == handle.generation;
+    }
+
 public:
-    // metodas nustatyti elementą
-    void setElement(T elem) {
-        element = elem;
+    Container() : count(0), freeHead(NO_SLOT) {
+    }
+
+    Handle insert(T value) {
+        if (freeHead == NO_SLOT) {
+            freeHead = static_cast<uint32_t>(slots.size());
+            slots.push_back(Slot{T(), 0, NO_SLOT});
+        }
+        uint32_t index = freeHead;
+        Slot& slot = slots[index];
+        freeHead = slot.nextFree;
+        slot.value = std::move(value);
+        uint32_t generation = ++slot.generation;
+        ++count;
+        return Handle{index, generation};
+    }
+
+    // Pašalina elementą; grąžina false, jei rankena jau nebegalioja
+    bool erase(Handle handle) {
+        if (!valid(handle)) {
+            return false;
+        }
+        Slot& slot = slots[handle.index];
+        ++slot.generation;
+        slot.nextFree = freeHead;
+        freeHead = handle.index;
+        --count;
+        return true;
     }
-    // metodas gauti elementą
-    T getElement() {
-        return element;
+
+    bool contains(Handle handle) const { return valid(handle); }
+
+    // Be patikrinimo; rankena turi galioti
+    T& operator[](Handle handle) { return slots[handle.index].value; }
+    const T& operator[](Handle handle) const { return slots[handle.index].value; }
+
+    size_t size() const { return count; }
+
+    // Pašalina visus elementus; visos rankenos nustoja galioti, bet atmintis lieka
+    void clear() {
+        freeHead = NO_SLOT;
+        // Rebuilt in reverse so the lowest index is handed out first, as on a fresh container
+        for (uint32_t i = static_cast<uint32_t>(slots.size()); i-- > 0;) {
+            Slot& slot = slots[i];
+            slot.generation += slot.generation & 1u;
+            slot.nextFree = freeHead;
+            freeHead = i;
+        }
+        count = 0;
     }
 };
 
-#endif // CONTAINER_H
\ No newline at end of file
+#endif // CONTAINER_H
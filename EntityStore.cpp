@@ -0,0 +1,64 @@
+#include "EntityStore.h"
+
+EntityId EntityStore::create(Cell position) {
+    // The handle is stored in place: passed to push_back() it is spilled to the stack as two
+    // 32-bit halves and read back whole, which stalls store forwarding on every create
+    uint32_t slot = static_cast<uint32_t>(entities.size());
+    entities.push_back(NO_ENTITY);
+    EntityId entity = slots.insert(slot);
+    entities[slot] = entity;
+    flags.push_back(0);
+    positions.push_back(position);
+    renderables.push_back(Renderable{0, 0, 0, 0});
+    pickables.push_back(Pickable{PICKABLE_BODY, 0});
+    return entity;
+}
+
+bool EntityStore::destroy(EntityId entity) {
+    if (!slots.contains(entity)) {
+        return false;
+    }
+    // The last entity moves into the freed slot, so every array stays dense
+    uint32_t slot = slots[entity];
+    uint32_t last = static_cast<uint32_t>(entities.size() - 1);
+    EntityId moved = entities[last];
+    entities[slot] = moved;
+    flags[slot] = flags[last];
+    positions[slot] = positions[last];
+    renderables[slot] = renderables[last];
+    pickables[slot] = pickables[last];
+    slots[moved] = slot;
+
+    entities.pop_back();
+    flags.pop_back();
+    positions.pop_back();
+    renderables.pop_back();
+    pickables.pop_back();
+    slots.erase(entity);
+    return true;
+}
+
+bool EntityStore::isAlive(EntityId entity) const {
+    return slots.contains(entity);
+}
+
+void EntityStore::clear() {
+    slots.clear();
+    entities.clear();
+    flags.clear();
+    positions.clear();
+    renderables.clear();
+    pickables.clear();
+}
+
+void EntityStore::setRenderable(EntityId entity, Renderable renderable) {
+    uint32_t slot = slots[entity];
+    renderables[slot] = renderable;
+    flags[slot] |= HAS_RENDERABLE;
+}
+
+void EntityStore::setPickable(EntityId entity, Pickable pickable) {
+    uint32_t slot = slots[entity];
+    pickables[slot] = pickable;
+    flags[slot] |= HAS_PICKABLE;
+}
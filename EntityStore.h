@@ -0,0 +1,68 @@
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Cell.h"
+#include "Container.h"
+
+// Subjekto rankena; pašalinto subjekto rankena nebetinka ir nerodo į naują subjektą
+using EntityId = Handle;
+const EntityId NO_ENTITY = NO_HANDLE;
+
+// Spalva be SFML priklausomybės, kad saugykla liktų branduolyje
+struct Renderable {
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    uint8_t a;
+};
+
+enum PickableKind : uint8_t { PICKABLE_BODY, PICKABLE_FOOD };
+
+// Ką rodo pelės žymeklis (PickingSystem)
+struct Pickable {
+    PickableKind kind;
+    uint16_t owner; // gyvatės numeris + 1 arba 0
+};
+
+// Kurie komponentai subjektui priskirti
+enum ComponentFlags : uint8_t { HAS_RENDERABLE = 1, HAS_PICKABLE = 2 };
+
+// Arenos piešimo talpykla: kiekvienas komponentas laikomas atskirame tankiame masyve, o RenderSystem
+// ir PickingSystem juos peržiūri tiesiškai, be virtualių kvietimų. Pašalinus subjektą, jo vietą
+// užima paskutinis, todėl masyvuose nelieka skylių. Kiekvienas subjektas turi poziciją.
+// Tai ne žaidimo būsena: gyvatės ir maistas gyvena Arena (vienai gyvatei - Simulation), kurios pačios
+// vykdo žingsnį ir tikrina susidūrimus, o ArenaViewer po kiekvieno žingsnio talpyklą užpildo iš naujo.
+class EntityStore {
+private:
+    std::vector<EntityId> entities; // kuriam subjektui priklauso i-toji masyvų vieta
+    std::vector<uint8_t> flags;
+    std::vector<Cell> positions;
+    std::vector<Renderable> renderables;
+    std::vector<Pickable> pickables;
+    Container<uint32_t> slots; // subjekto vieta tankiuose masyvuose
+public:
+    EntityId create(Cell position);
+    // Pašalina subjektą; grąžina false, jei jis jau pašalintas
+    bool destroy(EntityId entity);
+    bool isAlive(EntityId entity) const;
+    // Visi subjektai pašalinami, bet masyvų talpa lieka, kad kitas užpildymas neišskirtų atminties
+    void clear();
+    void setRenderable(EntityId entity, Renderable renderable);
+    void setPickable(EntityId entity, Pickable pickable);
+    void setPosition(EntityId entity, Cell position) { positions[slots[entity]] = position; }
+    Cell getPosition(EntityId entity) const { return positions[slots[entity]]; }
+    const Pickable& getPickable(EntityId entity) const { return pickables[slots[entity]]; }
+
+    // Tankūs masyvai sistemoms; visi size() ilgio
+    size_t size() const { return entities.size(); }
+    const EntityId* getEntities() const { return entities.data(); }
+    const uint8_t* getFlags() const { return flags.data(); }
+    const Cell* getPositions() const { return positions.data(); }
+    const Renderable* getRenderables() const { return renderables.data(); }
+    const Pickable* getPickables() const { return pickables.data(); }
+};
+
+#endif // ENTITYSTORE_H
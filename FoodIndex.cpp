@@ -0,0 +1,86 @@
+#include "FoodIndex.h"
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+
+FoodIndex::FoodIndex(int width, int height)
+    : width(width), height(height), tilesX((width + TILE_SIZE - 1) >> TILE_SHIFT),
+      tilesY((height + TILE_SIZE - 1) >> TILE_SHIFT), slots(static_cast<size_t>(width) * height, -1),
+      tiles(static_cast<size_t>(tilesX) * tilesY), tilePositions(static_cast<size_t>(width) * height, 0) {
+}
+
+void FoodIndex::clear() {
+    for (const Cell& cell : foods) {
+        slots[index(cell)] = -1;
+    }
+    foods.clear();
+    for (std::vector<uint32_t>& tile : tiles) {
+        tile.clear();
+    }
+}
+
+void FoodIndex::add(Cell cell) {
+    size_t i = index(cell);
+    slots[i] = static_cast<int32_t>(foods.size());
+    foods.push_back(cell);
+    std::vector<uint32_t>& tile = tiles[tileOf(cell)];
+    tilePositions[i] = static_cast<uint32_t>(tile.size());
+    tile.push_back(static_cast<uint32_t>(i));
+}
+
+void FoodIndex::remove(Cell cell) {
+    size_t i = index(cell);
+
+    // Swap-and-pop from the tile list, then from the dense list
+    std::vector<uint32_t>& tile = tiles[tileOf(cell)];
+    uint32_t movedCell = tile.back();
+    tile[tilePositions[i]] = movedCell;
+    tilePositions[movedCell] = tilePositions[i];
+    tile.pop_back();
+
+    int32_t slot = slots[i];
+    Cell moved = foods.back();
+    foods[slot] = moved;
+    slots[index(moved)] = slot;
+    foods.pop_back();
+    slots[i] = -1;
+}
+
+Cell FoodIndex::nearest(Cell from) const {
+    Cell best{-1, -1};
+    if (foods.empty()) {
+        return best;
+    }
+    int bestDistance = INT_MAX;
+    int tx = from.x >> TILE_SHIFT;
+    int ty = from.y >> TILE_SHIFT;
+    int maxRing = std::max(std::max(tx, tilesX - 1 - tx), std::max(ty, tilesY - 1 - ty));
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        // Walk the square ring of tiles at Chebyshev distance `ring` from the starting tile
+        for (int y = ty - ring; y <= ty + ring; ++y) {
+            if (y < 0 || y >= tilesY) {
+                continue;
+            }
+            bool edgeRow = y == ty - ring || y == ty + ring;
+            int step = edgeRow ? 1 : 2 * ring;
+            for (int x = tx - ring; x <= tx + ring; x += step > 0 ? step : 1) {
+                if (x < 0 || x >= tilesX) {
+                    continue;
+                }
+                for (uint32_t i : tiles[static_cast<size_t>(y) * tilesX + x]) {
+                    Cell cell{static_cast<int>(i % width), static_cast<int>(i / width)};
+                    int distance = std::abs(cell.x - from.x) + std::abs(cell.y - from.y);
+                    if (distance < bestDistance) {
+                        bestDistance = distance;
+                        best = cell;
+                    }
+                }
+            }
+        }
+        // Every cell in the next ring is at least ring * TILE_SIZE + 1 steps away
+        if (bestDistance <= ring * TILE_SIZE) {
+            break;
+        }
+    }
+    return best;
+}
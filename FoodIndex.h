@@ -0,0 +1,42 @@
+#ifndef FOODINDEX_H
+#define FOODINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Cell.h"
+
+// Maisto vietų erdvinė rodyklė: ar langelyje yra maistas, sužinoma per O(1), o artimiausias
+// maistas randamas tikrinant tik aplinkines 8x8 langelių plyteles, ne visą maisto sąrašą.
+class FoodIndex {
+private:
+    int width;
+    int height;
+    int tilesX;
+    int tilesY;
+    std::vector<Cell> foods; // tankus sąrašas piešimui ir iteracijai
+    std::vector<int32_t> slots; // maisto vieta foods[] sąraše kiekvienam langeliui arba -1
+    std::vector<std::vector<uint32_t>> tiles; // kiekvienos plytelės maisto langelių indeksai
+    std::vector<uint32_t> tilePositions; // kur langelio indeksas yra savo plytelės sąraše
+    size_t index(Cell cell) const { return static_cast<size_t>(cell.y) * width + cell.x; }
+    size_t tileOf(Cell cell) const {
+        return static_cast<size_t>(cell.y >> TILE_SHIFT) * tilesX + (cell.x >> TILE_SHIFT);
+    }
+public:
+    static constexpr int TILE_SHIFT = 3;
+    static constexpr int TILE_SIZE = 1 << TILE_SHIFT;
+
+    FoodIndex(int width, int height);
+    void clear();
+    // Langelyje dar neturi būti maisto
+    void add(Cell cell);
+    // Langelyje turi būti maistas
+    void remove(Cell cell);
+    bool contains(Cell cell) const { return slots[index(cell)] >= 0; }
+    size_t size() const { return foods.size(); }
+    Cell operator[](size_t i) const { return foods[i]; }
+    // Artimiausias maistas pagal Manheteno atstumą; {-1, -1}, jei maisto nėra
+    Cell nearest(Cell from) const;
+};
+
+#endif // FOODINDEX_H
@@ -0,0 +1,59 @@
+#include "FrameProfiler.h"
+#include <cstdio>
+
+FrameProfiler::FrameProfiler() : enabled(false), lastFrame(0), lastInterval(0), windowStart(0) {
+}
+
+void FrameProfiler::setEnabled(bool value) {
+    enabled = value;
+    if (enabled) {
+        reset();
+        lastFrame = 0;
+        lastInterval = 0;
+    }
+}
+
+void FrameProfiler::frame() {
+    if (!enabled) {
+        return;
+    }
+    uint64_t time = now();
+    if (lastFrame != 0) {
+        uint64_t interval = time - lastFrame;
+        frameIntervals.record(interval);
+        if (lastInterval != 0) {
+            jitter.record(interval > lastInterval ? interval - lastInterval : lastInterval - interval);
+        }
+        lastInterval = interval;
+    }
+    lastFrame = time;
+}
+
+static void appendRow(std::string& out, const char* name, const LatencyHistogram& histogram) {
+    char line[96];
+    std::snprintf(line, sizeof(line), "%-8s %7llu %8.3f %8.3f %8.3f %8.3f\n", name,
+                  static_cast<unsigned long long>(histogram.getCount()), histogram.getPercentile(0.5) / 1e6,
+                  histogram.getPercentile(0.99) / 1e6, histogram.getPercentile(0.999) / 1e6,
+                  histogram.getMax() / 1e6);
+    out += line;
+}
+
+std::string FrameProfiler::summary() const {
+    static const char* const NAMES[PHASE_COUNT] = {"events", "update", "render"};
+    std::string out = "phase      count      p50      p99     p999      max (ms)\n";
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        appendRow(out, NAMES[phase], phases[phase]);
+    }
+    appendRow(out, "frame", frameIntervals);
+    appendRow(out, "jitter", jitter);
+    return out;
+}
+
+void FrameProfiler::reset() {
+    for (LatencyHistogram& histogram : phases) {
+        histogram.clear();
+    }
+    frameIntervals.clear();
+    jitter.clear();
+    windowStart = now();
+}
@@ -0,0 +1,53 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "LatencyHistogram.h"
+
+enum FramePhase { PHASE_EVENTS, PHASE_UPDATE, PHASE_RENDER, PHASE_COUNT };
+
+// Žaidimo ciklo fazių trukmės ir kadrų tempas. Kiekviena fazė matuojama taip:
+//     uint64_t start = profiler.begin();
+//     ...
+//     profiler.end(PHASE_UPDATE, start);
+// Išjungus begin() ir end() laikrodžio neskaito - lieka tik viena šaka.
+// Kadrų intervalai ir jų svyravimas (dviejų gretimų intervalų skirtumas) kaupiami atskirai.
+class FrameProfiler {
+private:
+    bool enabled;
+    LatencyHistogram phases[PHASE_COUNT];
+    LatencyHistogram frameIntervals;
+    LatencyHistogram jitter;
+    uint64_t lastFrame; // 0 - kadro dar nebuvo
+    uint64_t lastInterval; // 0 - intervalo dar nebuvo
+    uint64_t windowStart; // kada paskutinį kartą išvalyta
+public:
+    FrameProfiler();
+    static uint64_t now() {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+    bool isEnabled() const { return enabled; }
+    // Įjungus pradedama iš naujo
+    void setEnabled(bool value);
+    uint64_t begin() const { return enabled ? now() : 0; }
+    void end(FramePhase phase, uint64_t start) {
+        if (enabled) {
+            phases[phase].record(now() - start);
+        }
+    }
+    // Kviečiama kiekvieną kartą parodžius kadrą
+    void frame();
+    // Kiek laiko kaupiama nuo paskutinio reset()
+    uint64_t getWindowNanoseconds() const { return now() - windowStart; }
+    const LatencyHistogram& getPhase(FramePhase phase) const { return phases[phase]; }
+    const LatencyHistogram& getFrameIntervals() const { return frameIntervals; }
+    const LatencyHistogram& getJitter() const { return jitter; }
+    // Lentelė: kiekvienai fazei, kadrų intervalui ir svyravimui - kiekis, p50, p99, p999 ir max milisekundėmis
+    std::string summary() const;
+    void reset();
+};
+
+#endif // FRAMEPROFILER_H
@@ -0,0 +1,87 @@
+#ifndef FREECELLINDEX_H
+#define FREECELLINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Laisvų langelių rodyklė virš užimtumo bitų lauko: Fenwick medis, kuriame saugoma,
+// kiek laisvų langelių yra kiekviename 64 bitų žodyje. Langelio užėmimas ar atlaisvinimas
+// (addFree) trunka O(log(langelių / 64)), n-tojo laisvo langelio eilutėmis paieška (selectFree) -
+// tiek pat plius ne daugiau nei 63 bitų nuėmimai rastame žodyje.
+// Tai pakeitė tankų laisvų langelių masyvą su atgalinėmis rodyklėmis, kuris abu veiksmus
+// atlikdavo per O(1), bet jo tvarka priklausė nuo ėjimų istorijos, kurios neišsaugo nei Snapshot,
+// nei kadrų įrašai, todėl atkurta būsena parinkdavo kitą maisto langelį. Čia rezultatas priklauso
+// tik nuo to, kurie langeliai užimti; 30x30 lentoje medis turi vos 15 elementų.
+// Medis turi wordCount + 1 elementą, indeksuojamas nuo 1.
+
+inline int countBits(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int count = 0;
+    for (; x; x &= x - 1) {
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline int lowestBit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int bit = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+// Kurie žodžio bitai atitinka tikrus langelius (paskutinis žodis gali būti neužpildytas)
+inline uint64_t validBits(size_t word, size_t cellCount) {
+    size_t remaining = cellCount - word * 64;
+    return remaining >= 64 ? ~uint64_t(0) : (uint64_t(1) << remaining) - 1;
+}
+
+inline void buildFreeTree(uint32_t* tree, const uint64_t* words, size_t wordCount, size_t cellCount) {
+    tree[0] = 0;
+    for (size_t i = 1; i <= wordCount; ++i) {
+        tree[i] = static_cast<uint32_t>(countBits(~words[i - 1] & validBits(i - 1, cellCount)));
+    }
+    for (size_t i = 1; i <= wordCount; ++i) {
+        size_t parent = i + (i & (~i + 1));
+        if (parent <= wordCount) {
+            tree[parent] += tree[i];
+        }
+    }
+}
+
+inline void addFree(uint32_t* tree, size_t wordCount, size_t word, int32_t delta) {
+    for (size_t i = word + 1; i <= wordCount; i += i & (~i + 1)) {
+        tree[i] += delta;
+    }
+}
+
+// Grąžina n-tojo laisvo langelio indeksą; 0 <= n < laisvų langelių skaičius
+inline size_t selectFree(const uint32_t* tree, const uint64_t* words, size_t wordCount, size_t cellCount, size_t n) {
+    size_t step = 1;
+    while (step * 2 <= wordCount) {
+        step *= 2;
+    }
+    size_t word = 0;
+    for (; step > 0; step >>= 1) {
+        if (word + step <= wordCount && tree[word + step] <= n) {
+            word += step;
+            n -= tree[word];
+        }
+    }
+    uint64_t freeBits = ~words[word] & validBits(word, cellCount);
+    for (; n > 0; --n) {
+        freeBits &= freeBits - 1;
+    }
+    return word * 64 + lowestBit(freeBits);
+}
+
+#endif // FREECELLINDEX_H
@@ -1,11 +1,38 @@
 #include "Game.h"
+#include <algorithm>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include "Tracer.h"
 
-const int WINDOW_WIDTH = 600;
-const int WINDOW_HEIGHT = 600;
+const int MAX_TICKS_PER_FRAME = 5;
+const sf::Time MAX_SLEEP = sf::milliseconds(10);
+// How often the profile is printed and the overlay refreshed, while profiling is on
+const uint64_t PROFILE_PERIOD_NS = 5000000000ull;
+// How long "Profiling off" stays on screen after F3 turns profiling off
+const uint64_t PROFILE_NOTICE_NS = 2000000000ull;
 
-Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Snake Game"), delay(0.2f), score(0), highScore(0), gameOver(false) {
-    srand(static_cast<unsigned int>(time(0)));
+// prefix_<time>.ext, or prefix_<time>_2.ext and so on when games end within the same second
+static std::string uniqueFilename(const std::string& prefix, const std::string& extension) {
+    std::string base = prefix + "_" + std::to_string(time(0));
+    std::string filename = base + extension;
+    for (int n = 2; std::ifstream(filename).good(); ++n) {
+        filename = base + "_" + std::to_string(n) + extension;
+    }
+    return filename;
+}
+
+Game::Game(float ticksPerSecond, unsigned int frameLimit, bool verticalSync)
+    : window(sf::VideoMode(GameBoard::PIXEL_WIDTH, GameBoard::PIXEL_HEIGHT), "Snake Game"), renderer(simulation), recording(true),
+      hasQuickSave(false), driver(PLAYER),
+      tickDuration(sf::seconds(1.f / ticksPerSecond)),
+      frameDuration(frameLimit > 0 ? sf::seconds(1.f / frameLimit) : sf::Time::Zero),
+      verticalSync(verticalSync), needsRender(true), nextDirection(simulation.getDirection()), highScore(0), displayedScore(-1), displayedHighScore(-1),
+      profileNoticeUntil(0) {
+    simulation.reset(static_cast<uint64_t>(time(0)));
+    recorder.start(simulation);
+    window.setVerticalSyncEnabled(verticalSync);
+    Tracer::attachThread("main");
 
    // Load font
     if (!font.loadFromFile("../resources/arial.ttf")) {
@@ -23,106 +50,313 @@ Game::Game() : window(sf::VideoMode(WINDOW_WIDTH, WINDOW_HEIGHT), "Snake Game"),
     highScoreText.setCharacterSize(24);
     highScoreText.setFillColor(sf::Color::White);
     highScoreText.setPosition(10, 40);
+
+    // Initialize game over text; its string is set when the game ends
+    gameOverText.setFont(font);
+    gameOverText.setCharacterSize(24);
+    gameOverText.setFillColor(sf::Color::White);
+    gameOverText.setPosition(50, GameBoard::PIXEL_HEIGHT / 2);
+
+    // Initialize profile overlay; filled in after the first period
+    profileText.setFont(font);
+    profileText.setCharacterSize(14);
+    profileText.setFillColor(sf::Color::Yellow);
+    profileText.setPosition(10, 80);
 }
 
 void Game::run() {
+    sf::Clock clock;
+    sf::Time accumulator = sf::Time::Zero;
+    sf::Time lastTime = clock.getElapsedTime();
+    sf::Time lastFrame = lastTime - frameDuration;
+    needsRender = true;
+
     while (window.isOpen()) {
+        uint64_t phaseStart = profiler.begin();
         handleEvents();
-        if (!gameOver) {
-            update();
+        profiler.end(PHASE_EVENTS, phaseStart);
+
+        // Advance the simulation by whole ticks only, so it does not depend on the frame rate
+        sf::Time now = clock.getElapsedTime();
+        accumulator += now - lastTime;
+        lastTime = now;
+        int ticks = 0;
+        while (accumulator >= tickDuration) {
+            if (ticks == MAX_TICKS_PER_FRAME) {
+                // Too far behind (e.g. the window was being dragged): drop the backlog
+                accumulator = sf::Time::Zero;
+                break;
+            }
+            if (!simulation.isGameOver()) {
+                phaseStart = profiler.begin();
+                update();
+                profiler.end(PHASE_UPDATE, phaseStart);
+                needsRender = true;
+            }
+            accumulator -= tickDuration;
+            ++ticks;
+        }
+
+        // Draw only when something changed, and no more often than the frame limit
+        now = clock.getElapsedTime();
+        if (needsRender && (verticalSync || now - lastFrame >= frameDuration)) {
+            phaseStart = profiler.begin();
+            render();
+            profiler.end(PHASE_RENDER, phaseStart);
+            profiler.frame();
+            lastFrame = now;
+            needsRender = false;
+        }
+        if (profiler.isEnabled() && profiler.getWindowNanoseconds() >= PROFILE_PERIOD_NS) {
+            reportProfile();
+        } else if (profileNoticeUntil != 0 && FrameProfiler::now() >= profileNoticeUntil) {
+            profileNoticeUntil = 0;
+            needsRender = true;
+        }
+
+        // Sleep until the next tick or the next allowed frame, whichever comes first
+        now = clock.getElapsedTime();
+        sf::Time wait = tickDuration - accumulator - (now - lastTime);
+        if (needsRender && !verticalSync) {
+            wait = std::min(wait, frameDuration - (now - lastFrame));
+        }
+        wait = std::min(wait, MAX_SLEEP);
+        if (wait > sf::Time::Zero) {
+            sf::sleep(wait);
         }
-        render();
+    }
+    // The file is only valid JSON once the session is closed
+    if (Tracer::isActive()) {
+        toggleTracing();
     }
 }
 
 void Game::handleEvents() {
+    TraceScope trace("Game::handleEvents");
     sf::Event event;
     while (window.pollEvent(event)) {
+        // Input comes from queued events, so key presses made while the loop sleeps are not lost
+        needsRender = true;
         if (event.type == sf::Event::Closed) {
             window.close();
-        }
-    }
-
-    if (sf::Keyboard::isKeyPressed(sf::Keyboard::Up)) {
-        snake.changeDirection(UP);
-    } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Down)) {
-        snake.changeDirection(DOWN);
-    } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Left)) {
-        snake.changeDirection(LEFT);
-    } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Right)) {
-        snake.changeDirection(RIGHT);
-    }
-
-    if (gameOver) {
-        if (sf::Keyboard::isKeyPressed(sf::Keyboard::R)) {
-            restartGame();
-        } else if (sf::Keyboard::isKeyPressed(sf::Keyboard::Q)) {
-            window.close();
+        } else if (event.type == sf::Event::KeyPressed) {
+            switch (event.key.code) {
+                case sf::Keyboard::Up: nextDirection = UP; break;
+                case sf::Keyboard::Down: nextDirection = DOWN; break;
+                case sf::Keyboard::Left: nextDirection = LEFT; break;
+                case sf::Keyboard::Right: nextDirection = RIGHT; break;
+                case sf::Keyboard::A:
+                    // The autopilot only patches its field tick by tick, and it missed every tick since it last drove
+                    if (driver != AUTOPILOT) {
+                        autopilot.invalidate();
+                    }
+                    driver = driver == AUTOPILOT ? PLAYER : AUTOPILOT;
+                    cancelSearch();
+                    break;
+                case sf::Keyboard::H:
+                    // Taking over mid-game, the body need not lie in cycle order yet
+                    if (driver != HAMILTONIAN) {
+                        hamiltonian.invalidate();
+                    }
+                    driver = driver == HAMILTONIAN ? PLAYER : HAMILTONIAN;
+                    cancelSearch();
+                    break;
+                case sf::Keyboard::M:
+                    if (!mcts) {
+                        mcts = std::make_unique<MctsController<GameBoard>>(0, 1, 20000,
+                                                                           std::make_shared<TranspositionTable>());
+                    }
+                    driver = driver == MCTS ? PLAYER : MCTS;
+                    cancelSearch();
+                    break;
+                case sf::Keyboard::F2: toggleTracing(); break;
+                case sf::Keyboard::F3:
+                    profiler.setEnabled(!profiler.isEnabled());
+                    profileText.setString(profiler.isEnabled() ? "Profiling..." : "Profiling off");
+                    profileNoticeUntil = profiler.isEnabled() ? 0 : FrameProfiler::now() + PROFILE_NOTICE_NS;
+                    break;
+                case sf::Keyboard::F5: hasQuickSave = save(quickSave); break;
+                case sf::Keyboard::F9:
+                    if (hasQuickSave) {
+                        restore(quickSave);
+                    }
+                    break;
+                case sf::Keyboard::R:
+                    if (simulation.isGameOver()) {
+                        restartGame();
+                    }
+                    break;
+                case sf::Keyboard::Q:
+                    if (simulation.isGameOver()) {
+                        window.close();
+                    }
+                    break;
+                default: break;
+            }
         }
     }
 }
 
 void Game::update() {
-    if (clock.getElapsedTime().asSeconds() > delay) {
-        snake.move();
-        if (snake.getHeadPosition() == food.getPosition()) {
-            snake.grow();
-            food.regenerate(snake.getBody());
-            score += 10;
-             if (score > highScore) {
-                highScore = score;
+    TraceScope trace("Game::update");
+    if (driver == AUTOPILOT) {
+        nextDirection = autopilot.decide(simulation);
+    } else if (driver == HAMILTONIAN) {
+        nextDirection = hamiltonian.decide(simulation);
+    } else if (driver == MCTS) {
+        // The search runs on the pool between ticks, so frames and input carry on; the snake
+        // holds still until the answer for its current state is in
+        if (!mcts->isSearching()) {
+            mcts->start(simulation);
+        }
+        if (mcts->isSearching()) {
+            if (!mcts->isReady()) {
+                return;
             }
-        } else {
-            snake.shrink();
+            nextDirection = mcts->finish();
         }
-        if (snake.checkCollision()) {
-            std::cout << "Game Over! Your score: " << score << std::endl;
-            gameOver = true;
+    }
+    StepResult result = simulation.step(nextDirection);
+    if (driver == MCTS) {
+        // Thinking about the next move starts right away, so it often finishes before the next tick
+        mcts->start(simulation);
+    }
+    recorder.record(simulation);
+    if (simulation.getScore() > highScore) {
+        highScore = simulation.getScore();
+    }
+    if (result.won) {
+        std::cout << "You Win! Your score: " << simulation.getScore() << std::endl;
+    } else if (result.gameOver) {
+        std::cout << "Game Over! Your score: " << simulation.getScore() << std::endl;
+    }
+    if (result.gameOver && driver == MCTS) {
+        std::cout << "MCTS: " << static_cast<long long>(mcts->getTotalStats().getPlayoutsPerSecond())
+                  << " playouts/s on " << mcts->getThreadCount() << " threads" << std::endl;
+    }
+    if (result.gameOver) {
+        setGameOverText();
+        if (recording) {
+            saveReplay();
         }
-        clock.restart();
     }
 }
 
+void Game::setGameOverText() {
+    gameOverText.setString(simulation.isWon() ? "You Win! Press R to Restart or Q to Quit"
+                                              : "Game Over! Press R to Restart or Q to Quit");
+}
+
 void Game::render() {
+    TraceScope trace("Game::render");
     window.clear();
-    snake.draw(window);
-    food.draw(window);
+    renderer.draw(window);
 
-    // Update score text
-    scoreText.setString("Score: " + std::to_string(score));
+    updateHud();
     window.draw(scoreText);
-
-    // Update high score text
-    highScoreText.setString("High Score: " + std::to_string(highScore));
     window.draw(highScoreText);
+    if (profiler.isEnabled() || profileNoticeUntil != 0) {
+        window.draw(profileText);
+    }
 
-    if (gameOver) {
+    if (simulation.isGameOver()) {
         gameOverScreen();
     }
 
+    TraceScope displayTrace("window.display");
     window.display();
 }
 
-void Game::gameOverScreen() {
-    sf::Font font;
-    if (!font.loadFromFile("../resources/arial.ttf")) {
-        std::cerr << "Could not load font!" << std::endl;
+void Game::updateHud() {
+    // Strings are rebuilt only when the numbers change, not every frame
+    if (simulation.getScore() != displayedScore) {
+        displayedScore = simulation.getScore();
+        scoreText.setString("Score: " + std::to_string(displayedScore));
+    }
+    if (highScore != displayedHighScore) {
+        displayedHighScore = highScore;
+        highScoreText.setString("High Score: " + std::to_string(displayedHighScore));
+    }
+}
+
+void Game::reportProfile() {
+    // Each period stands on its own, so a stutter is not averaged away by a long calm session
+    std::string summary = profiler.summary();
+    std::cout << summary << std::flush;
+    profileText.setString(summary);
+    profiler.reset();
+    needsRender = true;
+}
+
+void Game::toggleTracing() {
+    if (Tracer::isActive()) {
+        Tracer::stop();
+        std::cout << "Tracing stopped";
+        if (Tracer::getDroppedCount() > 0) {
+            std::cout << ", " << Tracer::getDroppedCount() << " events dropped";
+        }
+        std::cout << std::endl;
         return;
     }
+    std::string filename = uniqueFilename("trace", ".json");
+    if (Tracer::start(filename)) {
+        std::cout << "Tracing to " << filename << std::endl;
+    } else {
+        std::cerr << "Could not start tracing to " << filename << std::endl;
+    }
+}
 
-    sf::Text text;
-    text.setFont(font);
-    text.setString("Game Over! Press R to Restart or Q to Quit");
-    text.setCharacterSize(24);
-    text.setFillColor(sf::Color::White);
-    text.setPosition(50, WINDOW_HEIGHT / 2);
+void Game::gameOverScreen() {
+    window.draw(gameOverText);
+}
 
-    window.draw(text);
+void Game::cancelSearch() {
+    // A search started from an earlier state must not steer the snake once that state is gone
+    if (mcts) {
+        mcts->cancel();
+    }
 }
 
 void Game::restartGame() {
-    score = 0;
-    snake = Snake();
-    food.regenerate(snake.getBody());
-    gameOver = false;
+    simulation.reset();
+    renderer.invalidate();
+    autopilot.invalidate();
+    hamiltonian.invalidate();
+    cancelSearch();
+    recorder.start(simulation);
+    recording = true;
+    nextDirection = simulation.getDirection();
+    needsRender = true;
+}
+
+bool Game::save(Snapshot<GameBoard>& snapshot) const {
+    return simulation.save(snapshot);
+}
+
+bool Game::restore(const Snapshot<GameBoard>& snapshot) {
+    if (!simulation.restore(snapshot)) {
+        return false;
+    }
+    // The body was replaced wholesale, so nothing incremental can be kept
+    renderer.invalidate();
+    autopilot.invalidate();
+    hamiltonian.invalidate();
+    cancelSearch();
+    recording = false;
+    nextDirection = simulation.getDirection();
+    if (simulation.getScore() > highScore) {
+        highScore = simulation.getScore();
+    }
+    if (simulation.isGameOver()) {
+        setGameOverText();
+    }
+    needsRender = true;
+    return true;
+}
+
+void Game::saveReplay() {
+    std::string filename = uniqueFilename("replay", ".snr");
+    if (!recorder.getReplay().saveToFile(filename)) {
+        std::cerr << "Could not save replay to " << filename << std::endl;
+    }
 }
\ No newline at end of file
@@ -2,35 +2,65 @@
 #define GAME_H
 
 #include <SFML/Graphics.hpp>
-#include "Snake.h"
-#include "Food.h"
-#include "Container.h"
+#include <memory>
+#include "Simulation.h"
+#include "Autopilot.h"
+#include "HamiltonianController.h"
+#include "MctsController.h"
+#include "BoardRenderer.h"
+#include "FrameProfiler.h"
+#include "ReplayRecorder.h"
+#include "Snapshot.h"
 
 // Žaidimo klasė
 class Game {
 private:
     sf::RenderWindow window; // Žaidimo langas
-    Snake snake; // Gyvatė
-    Food food; // Maistas
-    sf::Clock clock; // Laikrodis
-    float delay;
-    int score;
+    Simulation simulation; // Žaidimo taisyklės be lango
+    BoardRenderer renderer; // Gyvatė ir maistas piešiami kartu
+    ReplayRecorder recorder; // kiekviena partija įrašoma į failą
+    bool recording; // atkūrus išsaugotą būseną partijos nebegalima pakartoti nuo pradžios
+    Snapshot<GameBoard> quickSave; // F5 išsaugo, F9 atkuria
+    bool hasQuickSave;
+    // Kas vairuoja gyvatę: žaidėjas, automatinis vairuotojas (klavišas A), Hamiltono ciklas (klavišas H)
+    // ar medžio paieška (klavišas M)
+    enum Driver { PLAYER, AUTOPILOT, HAMILTONIAN, MCTS };
+    Driver driver;
+    Autopilot autopilot;
+    HamiltonianController hamiltonian;
+    std::unique_ptr<MctsController<GameBoard>> mcts; // sukuriamas pirmą kartą įjungus, nes paleidžia gijas
+    sf::Time tickDuration; // vieno simuliacijos žingsnio trukmė
+    sf::Time frameDuration; // mažiausias laikas tarp kadrų (0 - neribojama)
+    bool verticalSync;
+    bool needsRender; // ar nuo paskutinio kadro kas nors pasikeitė
+    Direction nextDirection; // kryptis, kuri bus pritaikyta kitame žingsnyje
     int highScore;
-    bool gameOver;
-    sf::Font font;
+    sf::Font font; // užkraunamas vieną kartą konstruktoriuje
     sf::Text scoreText;
     sf::Text highScoreText;
+    sf::Text gameOverText;
+    int displayedScore; // rezultatai, kuriems paskutinį kartą sukurti tekstai
+    int displayedHighScore;
+    FrameProfiler profiler; // F3 įjungia fazių matavimą ir jo suvestinę ekrane
+    sf::Text profileText; // paskutinio laikotarpio suvestinė arba pranešimas, kad matavimas išjungtas
+    uint64_t profileNoticeUntil; // iki kada rodomas pranešimas "Profiling off"; 0 - nerodomas
+    void reportProfile();
+    void toggleTracing(); // F2 įrašo laiko juostą į trace_<laikas>.json
     void handleEvents();
     void update();
     void render();
+    void updateHud();
     void gameOverScreen();
     void restartGame();
-
-    Container<Snake> snakeContainer;
-    Container<Food> foodContainer;
+    void cancelSearch();
+    void saveReplay();
+    void setGameOverText();
 public:
-    Game();
+    explicit Game(float ticksPerSecond = 5.f, unsigned int frameLimit = 60, bool verticalSync = false);
     void run();
+    bool save(Snapshot<GameBoard>& snapshot) const;
+    // Atkuria būseną ir perpiešia lentą; įrašas šiai partijai nebesaugomas
+    bool restore(const Snapshot<GameBoard>& snapshot);
 };
 
 #endif // GAME_H
\ No newline at end of file
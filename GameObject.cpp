@@ -1 +0,0 @@
-#include "GameObject.h"
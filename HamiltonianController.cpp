@@ -0,0 +1,109 @@
+#include "HamiltonianController.h"
+
+// How many more foods' growth a shortcut must leave room for before the tail catches up
+const uint32_t FOODS_AHEAD = 4;
+
+HamiltonianController::HamiltonianController(int width, int height)
+    : cycle(HamiltonianCycle::get(width, height)), fallback(new Autopilot(width, height)), ordered(false) {
+}
+
+void HamiltonianController::invalidate() {
+    ordered = false;
+    fallback->invalidate();
+}
+
+bool HamiltonianController::isInCycleOrder(const Simulation& simulation) const {
+    // Walking back along the cycle from the head must meet the segments in body order;
+    // gaps are holes left by shortcuts and do no harm
+    Cell head = simulation.getHead();
+    uint32_t previous = 0;
+    bool first = true;
+    for (Cell cell : simulation.getBody()) {
+        if (first) {
+            first = false;
+            continue;
+        }
+        uint32_t behind = cycle->distance(cell, head);
+        if (behind <= previous) {
+            return false;
+        }
+        previous = behind;
+    }
+    return true;
+}
+
+Direction HamiltonianController::recover(const Simulation& simulation) {
+    // The autopilot patches its field every step, so it is asked even when its move is not taken
+    Direction planned = fallback->decide(simulation);
+    Cell head = simulation.getHead();
+    Direction follow = cycle->getDirection(head);
+    // Cells laid while following the cycle are in order; the rest leave through the tail
+    if (applyTurn(simulation.getDirection(), follow) == follow && simulation.isFree(moveCell(head, follow))) {
+        return follow;
+    }
+    return planned;
+}
+
+Direction HamiltonianController::decide(const Simulation& simulation) {
+    if (!cycle->isValid()) {
+        return fallback->decide(simulation);
+    }
+    Direction current = simulation.getDirection();
+    if (simulation.isGameOver()) {
+        ordered = false;
+        return current;
+    }
+    if (!ordered) {
+        ordered = isInCycleOrder(simulation);
+        if (!ordered) {
+            return recover(simulation);
+        }
+    }
+
+    // The body always lies in cycle order behind the head, so every cell the head can reach
+    // along the cycle before the tail is free, and jumping ahead keeps that order intact
+    Cell head = simulation.getHead();
+    const SnakeBody& body = simulation.getBody();
+    uint32_t length = cycle->getLength();
+    Direction follow = cycle->getDirection(head);
+    uint32_t toTail = body.size() > 1 ? cycle->distance(head, body.back()) : length;
+    uint32_t toFood = cycle->distance(head, simulation.getFood());
+    // The body spans length - toTail cycle cells, holes left by earlier shortcuts included. Each food
+    // eaten while following the cycle shrinks the gap before the tail, so shortcuts are only taken
+    // while the span plus the growth still owed and that of a few more foods stays within half the board.
+    uint32_t owed = static_cast<uint32_t>(simulation.getPendingGrowth()) + FOODS_AHEAD * GROWTH_PER_FOOD;
+    uint32_t spanLimit = length / 2;
+    Direction best = follow;
+    uint32_t bestSkip = 0;
+    if (applyTurn(current, follow) != follow) {
+        // Only a one-segment snake can face against the cycle (at the start of a game): step to
+        // the free cell nearest ahead on the cycle instead, which keeps the body in cycle order
+        uint32_t nearest = length;
+        for (int k = 0; k < 4; ++k) {
+            Direction direction = static_cast<Direction>(k);
+            Cell next = moveCell(head, direction);
+            if (applyTurn(current, direction) == direction && simulation.isFree(next) &&
+                cycle->distance(head, next) < nearest) {
+                nearest = cycle->distance(head, next);
+                best = direction;
+            }
+        }
+        return best;
+    }
+    for (int k = 0; k < 4; ++k) {
+        Direction direction = static_cast<Direction>(k);
+        Cell next = moveCell(head, direction);
+        if (applyTurn(current, direction) != direction || !simulation.isFree(next)) {
+            continue;
+        }
+        uint32_t skip = cycle->distance(head, next);
+        // Following the cycle is always safe; a shortcut must not pass the food or stretch the body too far
+        bool safe = direction == follow ||
+                (skip <= toFood && skip < toTail && length - (toTail - skip) + owed <= spanLimit);
+        if (safe && skip > bestSkip) {
+            best = direction;
+            bestSkip = skip;
+        }
+    }
+    return best;
+}
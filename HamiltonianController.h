@@ -0,0 +1,34 @@
+#ifndef HAMILTONIANCONTROLLER_H
+#define HAMILTONIANCONTROLLER_H
+
+#include <memory>
+#include "Autopilot.h"
+#include "Board.h"
+#include "HamiltonianCycle.h"
+#include "Rules.h"
+#include "Simulation.h"
+
+// Valdiklis didžiausiam rezultatui: eina Hamiltono ciklu, todėl gyvatė niekada neatsitrenkia į save,
+// o kol ji trumpa, kerpa kampus link maisto. Ar kirpti saugu, sprendžiama vien iš langelių
+// eilės numerių cikle, todėl kiekvienas sprendimas trunka O(1) net ir beveik pilnoje lentoje.
+// Tai saugu tik tada, kai kūnas guli ciklo tvarka už galvos. Perėmus partiją vidury (pvz. iš žaidėjo)
+// tai patikrinama, ir kol kūnas ne ciklo tvarka, einama ciklu, kai kitas ciklo langelis laisvas,
+// o kitaip - atsarginiu autopilotu; taip sena, netvarkinga kūno dalis palaipsniui nueina pro uodegą.
+class HamiltonianController {
+private:
+    std::shared_ptr<const HamiltonianCycle> cycle;
+    std::unique_ptr<Autopilot> fallback; // kol kūnas ne ciklo tvarka ir lentoms, kuriose ciklo nėra
+    bool ordered; // ar po paskutinio decide() kūnas gulėjo ciklo tvarka
+    bool isInCycleOrder(const Simulation& simulation) const; // per O(kūno ilgio)
+    Direction recover(const Simulation& simulation);
+public:
+    explicit HamiltonianController(int width = GameBoard::WIDTH, int height = GameBoard::HEIGHT);
+    Direction decide(const Simulation& simulation);
+    // decide() reikia kviesti kiekvieną žingsnį; praleidus žingsnius (perimant partiją) reikia kviesti
+    // invalidate(), kad kūno tvarka būtų patikrinta iš naujo
+    void invalidate();
+    // Ar valdiklis dar veda gyvatę atgal į ciklo tvarką
+    bool isRecovering() const { return !ordered; }
+};
+
+#endif // HAMILTONIANCONTROLLER_H
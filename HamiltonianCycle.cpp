@@ -0,0 +1,55 @@
+#include "HamiltonianCycle.h"
+#include <map>
+#include <mutex>
+#include <utility>
+
+// Boustrophedon cycle for an even number of rows: rows are swept right and left over
+// columns 1..width-1, and column 0 leads back up to the top
+static Direction evenRowsDirection(int x, int y, int width, int height) {
+    if (x == 0) {
+        return y == 0 ? RIGHT : UP;
+    }
+    if (y % 2 == 0) {
+        return x < width - 1 ? RIGHT : DOWN;
+    }
+    if (y == height - 1) {
+        return LEFT;
+    }
+    return x > 1 ? LEFT : DOWN;
+}
+
+HamiltonianCycle::HamiltonianCycle(int width, int height)
+    : width(width), height(height), length(static_cast<uint32_t>(width) * height), valid(false) {
+    if (width < 2 || height < 2 || (width % 2 != 0 && height % 2 != 0)) {
+        return;
+    }
+    order.assign(length, 0);
+    directions.assign(length, 0);
+    bool transposed = height % 2 != 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            Direction direction = transposed
+                    // Swapping the axes swaps UP with LEFT and DOWN with RIGHT
+                    ? static_cast<Direction>(evenRowsDirection(y, x, height, width) ^ 2)
+                    : evenRowsDirection(x, y, width, height);
+            directions[index(Cell{x, y})] = static_cast<uint8_t>(direction);
+        }
+    }
+    Cell cell{0, 0};
+    for (uint32_t i = 0; i < length; ++i) {
+        order[index(cell)] = i;
+        cell = moveCell(cell, getDirection(cell));
+    }
+    valid = true;
+}
+
+std::shared_ptr<const HamiltonianCycle> HamiltonianCycle::get(int width, int height) {
+    static std::mutex mutex;
+    static std::map<std::pair<int, int>, std::shared_ptr<const HamiltonianCycle>> cache;
+    std::lock_guard<std::mutex> lock(mutex);
+    std::shared_ptr<const HamiltonianCycle>& cycle = cache[std::make_pair(width, height)];
+    if (!cycle) {
+        cycle = std::make_shared<const HamiltonianCycle>(width, height);
+    }
+    return cycle;
+}
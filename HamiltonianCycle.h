@@ -0,0 +1,40 @@
+#ifndef HAMILTONIANCYCLE_H
+#define HAMILTONIANCYCLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Cell.h"
+#include "Rules.h"
+
+// Hamiltono ciklas per visą lentą: kiekvienas langelis aplankomas po kartą ir grįžtama į pradžią.
+// Ciklas egzistuoja tik tada, kai bent viena lentos kraštinė lyginė; kitaip isValid() grąžina false.
+class HamiltonianCycle {
+private:
+    int width;
+    int height;
+    uint32_t length;
+    std::vector<uint32_t> order; // langelio eilės numeris cikle
+    std::vector<uint8_t> directions; // kryptis į kitą ciklo langelį
+    bool valid;
+    size_t index(Cell cell) const { return static_cast<size_t>(cell.y) * width + cell.x; }
+public:
+    HamiltonianCycle(int width, int height);
+    // Bendras ciklas šiam lentos dydžiui: sukuriamas vieną kartą ir naudojamas visų valdiklių
+    static std::shared_ptr<const HamiltonianCycle> get(int width, int height);
+    bool isValid() const { return valid; }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    uint32_t getLength() const { return length; }
+    uint32_t getOrder(Cell cell) const { return order[index(cell)]; }
+    Direction getDirection(Cell cell) const { return static_cast<Direction>(directions[index(cell)]); }
+    // Kiek žingsnių ciklu nuo vieno langelio iki kito
+    uint32_t distance(Cell from, Cell to) const {
+        uint32_t a = order[index(from)];
+        uint32_t b = order[index(to)];
+        return b >= a ? b - a : b + length - a;
+    }
+};
+
+#endif // HAMILTONIANCYCLE_H
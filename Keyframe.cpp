@@ -0,0 +1,76 @@
+#include "Keyframe.h"
+#include "Varint.h"
+
+// Coordinates are stored shifted by one, because food is at (-1, -1) on a full board and a
+// dead snake's head can be one cell off the board
+static void writeCoordinate(std::vector<uint8_t>& out, int value) {
+    writeVarint(out, static_cast<uint64_t>(value + 1));
+}
+
+static bool readCoordinate(const uint8_t*& data, const uint8_t* end, int& value) {
+    uint64_t raw;
+    if (!readVarint(data, end, raw)) {
+        return false;
+    }
+    value = static_cast<int>(raw) - 1;
+    return true;
+}
+
+void encodeKeyframe(std::vector<uint8_t>& out, uint32_t tick, const SimulationState& state) {
+    writeVarint(out, tick);
+    writeVarint(out, state.direction);
+    writeVarint(out, static_cast<uint64_t>(state.pendingGrowth));
+    writeVarint(out, static_cast<uint64_t>(state.score));
+    writeVarint(out, (state.gameOver ? 1u : 0u) | (state.won ? 2u : 0u));
+    writeCoordinate(out, state.food.x);
+    writeCoordinate(out, state.food.y);
+    writeFixed64(out, state.random.key);
+    writeVarint(out, state.random.counter);
+    writeVarint(out, state.start.counter);
+
+    writeVarint(out, state.body.size());
+    writeCoordinate(out, state.body[0].x);
+    writeCoordinate(out, state.body[0].y);
+    uint8_t packed = 0;
+    for (size_t i = 1; i < state.body.size(); ++i) {
+        packed |= directionBetween(state.body[i - 1], state.body[i]) << (2 * ((i - 1) & 3));
+        if ((i - 1) % 4 == 3 || i + 1 == state.body.size()) {
+            out.push_back(packed);
+            packed = 0;
+        }
+    }
+}
+
+bool decodeKeyframe(const uint8_t*& data, const uint8_t* end, uint32_t& tick, SimulationState& state) {
+    uint64_t rawTick, direction, growth, score, flags, startCounter, length;
+    if (!readVarint(data, end, rawTick) || !readVarint(data, end, direction) || !readVarint(data, end, growth) ||
+        !readVarint(data, end, score) || !readVarint(data, end, flags) || !readCoordinate(data, end, state.food.x) ||
+        !readCoordinate(data, end, state.food.y) || !readFixed64(data, end, state.random.key) ||
+        !readVarint(data, end, state.random.counter) || !readVarint(data, end, startCounter) ||
+        !readVarint(data, end, length) || length == 0) {
+        return false;
+    }
+    tick = static_cast<uint32_t>(rawTick);
+    state.direction = static_cast<Direction>(direction & 3);
+    state.pendingGrowth = static_cast<int>(growth);
+    state.score = static_cast<int>(score);
+    state.gameOver = (flags & 1) != 0;
+    state.won = (flags & 2) != 0;
+    state.start = Random::State{state.random.key, startCounter};
+
+    size_t packedBytes = (length - 1 + 3) / 4;
+    Cell head;
+    if (!readCoordinate(data, end, head.x) || !readCoordinate(data, end, head.y) ||
+        static_cast<size_t>(end - data) < packedBytes) {
+        return false;
+    }
+    state.body.clear();
+    state.body.reserve(length);
+    state.body.push_back(head);
+    for (size_t i = 1; i < length; ++i) {
+        Direction step = static_cast<Direction>((data[(i - 1) / 4] >> (2 * ((i - 1) & 3))) & 3);
+        state.body.push_back(moveCell(state.body.back(), step));
+    }
+    data += packedBytes;
+    return true;
+}
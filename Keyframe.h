@@ -0,0 +1,14 @@
+#ifndef KEYFRAME_H
+#define KEYFRAME_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Simulation.h"
+
+// Pilna simuliacijos būsena po tick žingsnių, supakuota įrašų rinkiniui.
+// Kūnas saugomas kaip galvos langelis ir po 2 bitus (kryptį) kiekvienam kitam segmentui.
+void encodeKeyframe(std::vector<uint8_t>& out, uint32_t tick, const SimulationState& state);
+bool decodeKeyframe(const uint8_t*& data, const uint8_t* end, uint32_t& tick, SimulationState& state);
+
+#endif // KEYFRAME_H
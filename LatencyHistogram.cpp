@@ -0,0 +1,77 @@
+#include "LatencyHistogram.h"
+#include <cmath>
+
+static int highestBit(uint64_t x) {
+#if defined(__GNUC__)
+    return 63 - __builtin_clzll(x);
+#else
+    int bit = 0;
+    while (x >>= 1) {
+        ++bit;
+    }
+    return bit;
+#endif
+}
+
+LatencyHistogram::LatencyHistogram() {
+    clear();
+}
+
+size_t LatencyHistogram::bucketOf(uint64_t value) {
+    // Small values get a bucket each; above that every power of two is split into SUB_COUNT buckets
+    if (value < SUB_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    int shift = highestBit(value) - SUB_BITS;
+    if (shift > MAX_BITS - SUB_BITS - 1) {
+        return BUCKETS - 1;
+    }
+    return static_cast<size_t>(shift + 1) * SUB_COUNT + static_cast<size_t>((value >> shift) - SUB_COUNT);
+}
+
+uint64_t LatencyHistogram::highestIn(size_t bucket) {
+    if (bucket < SUB_COUNT) {
+        return bucket;
+    }
+    int shift = static_cast<int>(bucket / SUB_COUNT) - 1;
+    uint64_t lowest = (SUB_COUNT + bucket % SUB_COUNT) << shift;
+    return lowest + (uint64_t(1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t nanoseconds) {
+    ++counts[bucketOf(nanoseconds)];
+    ++count;
+    sum += nanoseconds;
+    if (nanoseconds > max) {
+        max = nanoseconds;
+    }
+}
+
+uint64_t LatencyHistogram::getPercentile(double fraction) const {
+    if (count == 0) {
+        return 0;
+    }
+    uint64_t rank = static_cast<uint64_t>(std::ceil(fraction * count));
+    if (rank == 0) {
+        rank = 1;
+    }
+    uint64_t seen = 0;
+    for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+        seen += counts[bucket];
+        if (seen >= rank) {
+            // The bucket bound can overshoot the largest value actually seen
+            uint64_t value = highestIn(bucket);
+            return value < max ? value : max;
+        }
+    }
+    return max;
+}
+
+void LatencyHistogram::clear() {
+    for (uint64_t& bucketCount : counts) {
+        bucketCount = 0;
+    }
+    count = 0;
+    sum = 0;
+    max = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef LATENCYHISTOGRAM_H
+#define LATENCYHISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+
+// HDR tipo trukmių histograma: kiekvienas dvejeto laipsnio intervalas padalintas į 32 vienodus
+// stulpelius, todėl bet kuri reikšmė iki ~18 minučių (2^40 ns) saugoma ne daugiau nei ~3 % paklaida.
+// record() - tik kelios bitų operacijos ir vienas skaitiklis, atmintis neišskiriama.
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BITS = 5;
+    static constexpr uint64_t SUB_COUNT = 1u << SUB_BITS;
+    static constexpr int MAX_BITS = 40; // didesnės reikšmės įrašomos į paskutinį stulpelį
+    static constexpr size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    uint64_t counts[BUCKETS];
+    uint64_t count;
+    uint64_t sum;
+    uint64_t max;
+
+    static size_t bucketOf(uint64_t value);
+    // Didžiausia reikšmė, patenkanti į stulpelį
+    static uint64_t highestIn(size_t bucket);
+public:
+    LatencyHistogram();
+    void record(uint64_t nanoseconds);
+    // Reikšmė, kurios neviršija fraction (0..1) dalis įrašų, pvz. 0.99 - p99; 0, jei įrašų nėra
+    uint64_t getPercentile(double fraction) const;
+    uint64_t getCount() const { return count; }
+    uint64_t getMax() const { return max; }
+    double getMean() const { return count > 0 ? static_cast<double>(sum) / count : 0; }
+    void clear();
+};
+
+#endif // LATENCYHISTOGRAM_H
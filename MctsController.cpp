@@ -0,0 +1,366 @@
+#include "MctsController.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+// Exploration constant for rewards in [0, 1]
+const double EXPLORATION = 0.5;
+
+// The snake's left, indexed by its current direction (UP, DOWN, LEFT, RIGHT)
+static const Direction TURN_LEFT[4] = {LEFT, RIGHT, DOWN, UP};
+
+// Child k of a node: 0 keeps going straight, 1 turns left, 2 turns right
+static Direction relativeDirection(Direction current, uint32_t action) {
+    if (action == 0) {
+        return current;
+    }
+    Direction left = TURN_LEFT[current];
+    return action == 1 ? left : oppositeDirection(left);
+}
+
+// The search only runs on a simulation of exactly BoardT's size (decide() checks it through save()),
+// so cells are looked up with the compile-time width instead of Simulation::isFree
+template <typename BoardT>
+static bool isFree(const Simulation& simulation, Cell cell) {
+    return BoardT::contains(cell) && !BoardT::test(simulation.getOccupancyWords(), cell);
+}
+
+// Rollout policy: mostly the safe move closest to the food, sometimes any safe move
+template <typename BoardT>
+static Direction rolloutDirection(const Simulation& simulation, Random& random) {
+    Direction current = simulation.getDirection();
+    Cell head = simulation.getHead();
+    Cell food = simulation.getFood();
+    Direction safe[3];
+    uint32_t safeCount = 0;
+    Direction closest = current;
+    int closestDistance = INT32_MAX;
+    for (uint32_t action = 0; action < 3; ++action) {
+        Direction direction = relativeDirection(current, action);
+        Cell next = moveCell(head, direction);
+        if (!isFree<BoardT>(simulation, next)) {
+            continue;
+        }
+        safe[safeCount++] = direction;
+        int distance = std::abs(next.x - food.x) + std::abs(next.y - food.y);
+        if (distance < closestDistance) {
+            closestDistance = distance;
+            closest = direction;
+        }
+    }
+    if (safeCount == 0) {
+        return current;
+    }
+    return random.below(16) != 0 ? closest : safe[random.below(safeCount)];
+}
+
+template <typename BoardT>
+MctsController<BoardT>::MctsController(size_t threads, size_t treeCount, uint32_t playouts,
+                                       std::shared_ptr<TranspositionTable> table)
+    : playoutsPerDecision(playouts), table(std::move(table)), remaining(0), cacheHits(0), activeWorkers(0),
+      searching(false), decisions(0), lastStats{0, 0, 0, 0}, totalStats{0, 0, 0, 0}, pool(threads) {
+    // Every tree needs at least one thread searching it
+    treeCount = std::max<size_t>(1, std::min(treeCount, pool.size()));
+    // Every playout expands at most one node, and each thread may overshoot the budget by one
+    nodeCapacity = 1 + ACTIONS * (playouts / static_cast<uint32_t>(treeCount) + static_cast<uint32_t>(pool.size()) + 1);
+    for (size_t i = 0; i < treeCount; ++i) {
+        trees.push_back(std::make_unique<Tree>());
+        trees.back()->nodes.reset(new Node[nodeCapacity]);
+        trees.back()->used = 1;
+    }
+    for (size_t i = 0; i < pool.size(); ++i) {
+        scratch.push_back(std::make_unique<Simulation>(BoardT::WIDTH, BoardT::HEIGHT));
+    }
+}
+
+template <typename BoardT>
+MctsController<BoardT>::~MctsController() {
+    // A search still running stops after its current playouts; the pool then joins its threads
+    remaining.store(0, std::memory_order_relaxed);
+}
+
+template <typename BoardT>
+void MctsController<BoardT>::expand(Tree& tree, Node& node) {
+    // One thread wins the right to expand; the others treat the node as a leaf meanwhile
+    uint32_t expected = 0;
+    if (!node.children.compare_exchange_strong(expected, NO_CHILDREN, std::memory_order_acq_rel)) {
+        return;
+    }
+    uint32_t first = tree.used.fetch_add(ACTIONS, std::memory_order_relaxed);
+    if (first + ACTIONS > nodeCapacity) {
+        // The tree is full: the node stays a leaf for the rest of this decision
+        return;
+    }
+    for (uint32_t i = first; i < first + ACTIONS; ++i) {
+        Node& child = tree.nodes[i];
+        child.visits.store(0, std::memory_order_relaxed);
+        child.virtualLoss.store(0, std::memory_order_relaxed);
+        child.value.store(0, std::memory_order_relaxed);
+        child.children.store(0, std::memory_order_relaxed);
+    }
+    node.children.store(first, std::memory_order_release);
+}
+
+template <typename BoardT>
+uint32_t MctsController<BoardT>::select(const Tree& tree, uint32_t node, uint32_t first,
+                                        const Simulation& simulation) const {
+    const Node& parent = tree.nodes[node];
+    double logVisits = std::log(1.0 + parent.visits.load(std::memory_order_relaxed) +
+                                parent.virtualLoss.load(std::memory_order_relaxed));
+    // Moves straight into a wall or the body are never searched unless nothing else is left;
+    // their zero rewards would only drag down the means the decision is made from
+    Cell head = simulation.getHead();
+    Direction current = simulation.getDirection();
+    bool anySafe = false;
+    bool safe[ACTIONS];
+    for (uint32_t action = 0; action < ACTIONS; ++action) {
+        safe[action] = isFree<BoardT>(simulation, moveCell(head, relativeDirection(current, action)));
+        anySafe = anySafe || safe[action];
+    }
+    uint32_t best = first;
+    double bestScore = -1;
+    for (uint32_t child = first; child < first + ACTIONS; ++child) {
+        if (anySafe && !safe[child - first]) {
+            continue;
+        }
+        const Node& candidate = tree.nodes[child];
+        // Threads still inside a child count as visits that earned nothing, which steers others away
+        uint32_t visits = candidate.visits.load(std::memory_order_relaxed) +
+                          candidate.virtualLoss.load(std::memory_order_relaxed);
+        if (visits == 0) {
+            return child;
+        }
+        double mean = static_cast<double>(candidate.value.load(std::memory_order_relaxed)) / VALUE_SCALE / visits;
+        double score = mean + EXPLORATION * std::sqrt(logVisits / visits);
+        if (score > bestScore) {
+            bestScore = score;
+            best = child;
+        }
+    }
+    return best;
+}
+
+template <typename BoardT>
+void MctsController<BoardT>::playout(Tree& tree, Simulation& simulation, Random& random, Random::State food) {
+    simulation.restore(root);
+    // The snapshot carries the real game's stream, which already knows where every future food lands
+    simulation.setRandomState(food);
+    uint32_t path[MAX_DEPTH + 1];
+    size_t depth = 0;
+    uint32_t node = 0;
+    path[0] = 0;
+    tree.nodes[0].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+
+    int ateAt = -1; // step of the first food, or -1
+    int steps = 0;
+    StepResult result{false, false, false};
+
+    // Selection: walk down the expanded part of the tree, expanding the leaf on its second visit
+    while (!result.gameOver) {
+        Node& current = tree.nodes[node];
+        uint32_t first = current.children.load(std::memory_order_acquire);
+        if (first == 0 && depth < MAX_DEPTH && current.visits.load(std::memory_order_relaxed) > 0) {
+            expand(tree, current);
+            first = current.children.load(std::memory_order_acquire);
+        }
+        if (first == 0 || first == NO_CHILDREN) {
+            break;
+        }
+        uint32_t child = select(tree, node, first, simulation);
+        result = simulation.step(relativeDirection(simulation.getDirection(), child - first));
+        if (result.ateFood && ateAt < 0) {
+            ateAt = steps;
+        }
+        ++steps;
+        node = child;
+        path[++depth] = node;
+        tree.nodes[node].virtualLoss.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Dying in the tree is worth nothing; otherwise the leaf is scored by rollouts, or by the
+    // table when this state has been rolled out before
+    double reward = result.won ? 1.0 : 0.0;
+    if (!result.gameOver) {
+        bool fed = ateAt >= 0;
+        double outcome = evaluate(simulation, steps, fed, random);
+        reward = fed ? outcome * (1.0 - 0.5 * ateAt / HORIZON) : outcome;
+    }
+    uint64_t value = static_cast<uint64_t>(reward * VALUE_SCALE);
+    for (size_t i = 0; i <= depth; ++i) {
+        Node& visited = tree.nodes[path[i]];
+        visited.value.fetch_add(value, std::memory_order_relaxed);
+        visited.visits.fetch_add(1, std::memory_order_relaxed);
+        visited.virtualLoss.fetch_sub(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename BoardT>
+double MctsController<BoardT>::rollout(Simulation& simulation, int steps, bool fed, Random& random) {
+    // Play the cheap policy to the horizon, which also checks that eating was survivable
+    int ateAt = -1;
+    StepResult result{false, false, false};
+    for (; !result.gameOver && steps < HORIZON; ++steps) {
+        result = simulation.step(rolloutDirection<BoardT>(simulation, random));
+        if (result.ateFood && ateAt < 0) {
+            ateAt = steps;
+        }
+    }
+    // After food in the tree only survival is left to measure. Otherwise surviving without food is
+    // worth 0.25-0.5 by how close the head ended to the food, and eating is worth 0.5-1 by how soon,
+    // so the signal does not fade with distance
+    if (result.won) {
+        return 1.0;
+    } else if (result.gameOver) {
+        return 0.0;
+    } else if (fed) {
+        return 1.0;
+    } else if (ateAt >= 0) {
+        return 1.0 - 0.5 * ateAt / HORIZON;
+    }
+    Cell head = simulation.getHead();
+    Cell food = simulation.getFood();
+    int distance = std::abs(head.x - food.x) + std::abs(head.y - food.y);
+    return 0.5 - 0.25 * distance / (BoardT::WIDTH + BoardT::HEIGHT);
+}
+
+template <typename BoardT>
+double MctsController<BoardT>::evaluate(Simulation& simulation, int steps, bool fed, Random& random) {
+    if (!table) {
+        return rollout(simulation, steps, fed, random);
+    }
+    // The outcome depends on the board, the steps already taken and whether food was eaten on the way.
+    // The entry keeps the number of rollouts from this state (high half) and the sum of their outcomes
+    uint64_t key = simulation.getHash() ^ ((static_cast<uint64_t>(steps) * 2 + fed + 1) * 0x9E3779B97F4A7C15ull);
+    uint64_t data = 0;
+    uint64_t samples = 0;
+    uint64_t sum = 0;
+    if (table->probe(key, data)) {
+        samples = data >> 32;
+        sum = data & 0xFFFFFFFFu;
+    }
+    // Once enough rollouts agree on a state, their mean is a better estimate than one more rollout
+    if (samples >= CACHED_SAMPLES) {
+        cacheHits.fetch_add(1, std::memory_order_relaxed);
+        return static_cast<double>(sum) / VALUE_SCALE / samples;
+    }
+    double outcome = rollout(simulation, steps, fed, random);
+    sum += static_cast<uint64_t>(outcome * VALUE_SCALE);
+    ++samples;
+    // Two threads updating one entry at once lose a sample, which only costs a later rollout
+    table->store(key, samples << 32 | sum);
+    // Earlier rollouts from the same state, by any path, tree or controller, are averaged in
+    return static_cast<double>(sum) / VALUE_SCALE / samples;
+}
+
+template <typename BoardT>
+void MctsController<BoardT>::search(size_t worker) {
+    Random random(decisions, worker);
+    Tree& tree = *trees[worker % trees.size()];
+    Simulation& simulation = *scratch[worker];
+    // Food is drawn from a stream of its own, apart from the rollout policy's, and every playout
+    // starts 2^32 numbers further along it, so playouts see different future food
+    uint64_t foodKey = Random::makeKey(decisions, scratch.size() + worker);
+    for (uint64_t iteration = 0; remaining.fetch_sub(1, std::memory_order_relaxed) > 0; ++iteration) {
+        playout(tree, simulation, random, Random::State{foodKey, iteration << 32});
+    }
+    if (activeWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        searchFinished = std::chrono::steady_clock::now();
+    }
+}
+
+template <typename BoardT>
+Direction MctsController<BoardT>::decide(const Simulation& simulation) {
+    if (!start(simulation)) {
+        return simulation.getDirection();
+    }
+    return finish();
+}
+
+template <typename BoardT>
+bool MctsController<BoardT>::start(const Simulation& simulation) {
+    // The workers read root until they are done, so it is only replaced once the last search is collected
+    if (searching || simulation.isGameOver() || !simulation.save(root)) {
+        return false;
+    }
+    ++decisions;
+    for (auto& tree : trees) {
+        tree->used.store(1, std::memory_order_relaxed);
+        Node& top = tree->nodes[0];
+        top.visits.store(0, std::memory_order_relaxed);
+        top.virtualLoss.store(0, std::memory_order_relaxed);
+        top.value.store(0, std::memory_order_relaxed);
+        top.children.store(0, std::memory_order_relaxed);
+    }
+    remaining.store(playoutsPerDecision, std::memory_order_relaxed);
+    cacheHits.store(0, std::memory_order_relaxed);
+    activeWorkers.store(scratch.size(), std::memory_order_relaxed);
+    searching = true;
+
+    searchStarted = std::chrono::steady_clock::now();
+    for (size_t worker = 0; worker < scratch.size(); ++worker) {
+        pool.submit([this, worker] { search(worker); });
+    }
+    return true;
+}
+
+template <typename BoardT>
+void MctsController<BoardT>::cancel() {
+    if (!searching) {
+        return;
+    }
+    remaining.store(0, std::memory_order_relaxed);
+    pool.wait();
+    searching = false;
+}
+
+template <typename BoardT>
+Direction MctsController<BoardT>::finish() {
+    if (!searching) {
+        return root.direction;
+    }
+    pool.wait();
+    searching = false;
+    // Timed by the workers, so a caller collecting the result late does not lower playouts/s
+    double seconds = std::chrono::duration<double>(searchFinished - searchStarted).count();
+
+    // Root parallelism: the trees' root children are pooled before choosing
+    uint64_t visits[ACTIONS] = {0, 0, 0};
+    uint64_t values[ACTIONS] = {0, 0, 0};
+    uint64_t nodes = 0;
+    for (auto& tree : trees) {
+        uint32_t first = tree->nodes[0].children.load(std::memory_order_acquire);
+        if (first != 0 && first != NO_CHILDREN) {
+            for (uint32_t action = 0; action < ACTIONS; ++action) {
+                visits[action] += tree->nodes[first + action].visits.load(std::memory_order_relaxed);
+                values[action] += tree->nodes[first + action].value.load(std::memory_order_relaxed);
+            }
+        }
+        nodes += std::min(tree->used.load(std::memory_order_relaxed), nodeCapacity);
+    }
+    lastStats = MctsStats{playoutsPerDecision, nodes, cacheHits.load(std::memory_order_relaxed), seconds};
+    totalStats.playouts += playoutsPerDecision;
+    totalStats.nodes += nodes;
+    totalStats.cacheHits += lastStats.cacheHits;
+    totalStats.seconds += seconds;
+
+    // Moves that differ by a step or two towards the food have close means, so the best mean wins
+    // among the moves that were searched well enough for their mean to be trusted
+    uint64_t mostVisits = std::max(visits[0], std::max(visits[1], visits[2]));
+    uint32_t best = 0;
+    double bestMean = -1;
+    for (uint32_t action = 0; action < ACTIONS; ++action) {
+        if (visits[action] == 0 || visits[action] * 4 < mostVisits) {
+            continue;
+        }
+        double mean = static_cast<double>(values[action]) / visits[action];
+        if (mean > bestMean) {
+            bestMean = mean;
+            best = action;
+        }
+    }
+    return relativeDirection(root.direction, best);
+}
+
+template class MctsController<Board30>;
+template class MctsController<Board64>;
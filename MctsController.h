@@ -0,0 +1,111 @@
+#ifndef MCTSCONTROLLER_H
+#define MCTSCONTROLLER_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Board.h"
+#include "Random.h"
+#include "Rules.h"
+#include "Simulation.h"
+#include "Snapshot.h"
+#include "ThreadPool.h"
+#include "TranspositionTable.h"
+
+// Paieškos suvestinė: žaidimų iki galo (playout) skaičius ir trukmė
+struct MctsStats {
+    uint64_t playouts;
+    uint64_t nodes; // kiek medžio mazgų sukurta
+    uint64_t cacheHits; // kiek kartų žaidimas iki galo praleistas, nes įvertis rastas lentelėje
+    double seconds;
+
+    double getPlayoutsPerSecond() const { return seconds > 0 ? playouts / seconds : 0; }
+};
+
+// Monte Karlo medžio paieška: kiekvienam sprendimui suvaidinama playouts tęsinių nuo dabartinės
+// būsenos, būsenas klonuojant per Snapshot. Visos gijos dalijasi medžiu (medžio lygiagretumas):
+// mazgų statistika - atominiai skaitikliai be užraktų, o virtualus pralaimėjimas nukreipia
+// gijas į skirtingas šakas. Nurodžius kelis medžius, gijos paskirstomos jiems, o sprendimas
+// priimamas sudėjus šaknų vaikų įverčius (šaknies lygiagretumas). Žaidimų iki galo rezultatai
+// kaupiami perstatų lentelėje pagal būsenos Zobrist maišą: ta pati būsena, pasiekta kitu keliu
+// ar kito valdiklio, dalijančio lentelę, vertinama visų jos žaidimų vidurkiu, o surinkus
+// CACHED_SAMPLES žaidimų - nebežaidžiama. Paieška vyksta gijų telkinyje, todėl žaidimo ciklas gali
+// ją pradėti start(), o kryptį paimti finish() vėlesniame žingsnyje, kai isReady().
+// Apibrėžta Board30 ir Board64 lentoms (žr. MctsController.cpp).
+template <typename BoardT>
+class MctsController {
+private:
+    struct Node {
+        std::atomic<uint32_t> visits;
+        std::atomic<uint32_t> virtualLoss; // gijos, šiuo metu einančios per mazgą
+        std::atomic<uint64_t> value; // naudų suma, padauginta iš VALUE_SCALE
+        std::atomic<uint32_t> children; // pirmas iš ACTIONS vaikų; 0 - neišskleista
+    };
+
+    // Mazgai išskiriami iš anksto ir dalinami didinant used, todėl paieška neišskiria atminties
+    struct Tree {
+        std::unique_ptr<Node[]> nodes;
+        std::atomic<uint32_t> used;
+    };
+
+    static constexpr uint32_t ACTIONS = 3; // tiesiai, į kairę, į dešinę
+    static constexpr uint32_t NO_CHILDREN = UINT32_MAX; // išskleidžiamas arba medis pilnas
+    static constexpr size_t MAX_DEPTH = 64;
+    static constexpr uint64_t VALUE_SCALE = 1u << 16;
+    static constexpr int HORIZON = BoardT::WIDTH + BoardT::HEIGHT; // žingsnių viename žaidime iki galo
+    static constexpr uint64_t CACHED_SAMPLES = 16; // po tiek žaidimų iki galo būsenos vidurkiu pasitikima
+
+    uint32_t playoutsPerDecision;
+    uint32_t nodeCapacity;
+    std::shared_ptr<TranspositionTable> table;
+    std::vector<std::unique_ptr<Tree>> trees;
+    std::vector<std::unique_ptr<Simulation>> scratch; // kiekvienos gijos simuliacija
+    Snapshot<BoardT> root;
+    std::atomic<int64_t> remaining; // dar neišdalinti žaidimai iki galo
+    std::atomic<uint64_t> cacheHits;
+    std::atomic<size_t> activeWorkers;
+    std::chrono::steady_clock::time_point searchStarted;
+    std::chrono::steady_clock::time_point searchFinished; // rašo paskutinė baigusi gija
+    bool searching; // start() pavyko, o finish() ar cancel() dar nekviesta
+    uint64_t decisions;
+    MctsStats lastStats;
+    MctsStats totalStats;
+    ThreadPool pool; // paskutinis, kad gijos sustotų anksčiau nei sunaikinami medžiai
+
+    void search(size_t worker);
+    // food - srautas, iš kurio šiame žaidime iki galo atsiras nauji maisto vienetai
+    void playout(Tree& tree, Simulation& simulation, Random& random, Random::State food);
+    // Lapo įvertis [0, 1]: steps - jau nueita žingsnių, fed - ar maistas jau suvalgytas
+    double evaluate(Simulation& simulation, int steps, bool fed, Random& random);
+    double rollout(Simulation& simulation, int steps, bool fed, Random& random);
+    uint32_t select(const Tree& tree, uint32_t node, uint32_t first, const Simulation& simulation) const;
+    void expand(Tree& tree, Node& node);
+public:
+    // threads = 0 - tiek gijų, kiek branduolių; trees - nepriklausomų medžių skaičius;
+    // table - kelių valdiklių bendra perstatų lentelė (nullptr - be lentelės)
+    explicit MctsController(size_t threads = 0, size_t trees = 1, uint32_t playouts = 20000,
+                            std::shared_ptr<TranspositionTable> table = nullptr);
+    ~MctsController();
+    // Sprendimas iš karto: start() ir finish()
+    Direction decide(const Simulation& simulation);
+    // Pradeda paiešką fone ir grįžta nelaukdamas; simulation po to galima keisti.
+    // false, jei partija baigta, lentos dydis ne BoardT arba ankstesnė paieška dar nebaigta (finish()/cancel())
+    bool start(const Simulation& simulation);
+    // Ar start() pradėta paieška jau baigė visus žaidimus iki galo
+    bool isReady() const { return pool.isIdle(); }
+    // Kryptis būsenai, nuo kurios pradėta paieška; jei ji dar nebaigta, laukiama
+    Direction finish();
+    // Nutraukia paiešką (gijos baigia tik pradėtus žaidimus) ir atmeta jos rezultatą
+    void cancel();
+    bool isSearching() const { return searching; }
+    const MctsStats& getLastStats() const { return lastStats; }
+    // Visų sprendimų suma nuo sukūrimo
+    const MctsStats& getTotalStats() const { return totalStats; }
+    size_t getThreadCount() const { return pool.size(); }
+    size_t getTreeCount() const { return trees.size(); }
+};
+
+#endif // MCTSCONTROLLER_H
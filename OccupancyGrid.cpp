@@ -0,0 +1,46 @@
+#include "OccupancyGrid.h"
+#include <algorithm>
+#include "FreeCellIndex.h"
+
+OccupancyGrid::OccupancyGrid(int width, int height)
+    : width(width), height(height), words((static_cast<size_t>(width) * height + 63) / 64, 0),
+      freeTree(words.size() + 1) {
+    reset();
+}
+
+void OccupancyGrid::reset() {
+    std::fill(words.begin(), words.end(), 0);
+    freeCount = static_cast<size_t>(width) * height;
+    buildFreeTree(freeTree.data(), words.data(), words.size(), freeCount);
+}
+
+void OccupancyGrid::assign(const uint64_t* sourceWords, const uint32_t* sourceTree, size_t sourceFreeCount) {
+    std::copy(sourceWords, sourceWords + words.size(), words.begin());
+    std::copy(sourceTree, sourceTree + freeTree.size(), freeTree.begin());
+    freeCount = sourceFreeCount;
+}
+
+void OccupancyGrid::set(Cell cell) {
+    if (test(cell)) {
+        return;
+    }
+    size_t i = index(cell);
+    words[i >> 6] |= uint64_t(1) << (i & 63);
+    addFree(freeTree.data(), words.size(), i >> 6, -1);
+    --freeCount;
+}
+
+void OccupancyGrid::clear(Cell cell) {
+    if (!test(cell)) {
+        return;
+    }
+    size_t i = index(cell);
+    words[i >> 6] &= ~(uint64_t(1) << (i & 63));
+    addFree(freeTree.data(), words.size(), i >> 6, 1);
+    ++freeCount;
+}
+
+Cell OccupancyGrid::getFreeCell(size_t n) const {
+    size_t i = selectFree(freeTree.data(), words.data(), words.size(), static_cast<size_t>(width) * height, n);
+    return Cell{static_cast<int>(i % width), static_cast<int>(i / width)};
+}
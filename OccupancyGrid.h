@@ -0,0 +1,43 @@
+#ifndef OCCUPANCYGRID_H
+#define OCCUPANCYGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Cell.h"
+
+// Supakuotas bitų laukas: vienas bitas kiekvienam lentos langeliui.
+// Kartu laikoma laisvų langelių rodyklė (FreeCellIndex.h), kad laisvą langelį būtų galima parinkti be paieškos:
+// set(), clear() ir getFreeCell() trunka O(log(langelių / 64)), test() - O(1).
+class OccupancyGrid {
+private:
+    int width;
+    int height;
+    std::vector<uint64_t> words;
+    std::vector<uint32_t> freeTree;
+    size_t freeCount;
+    size_t index(Cell cell) const { return static_cast<size_t>(cell.y) * width + cell.x; }
+public:
+    OccupancyGrid(int width, int height);
+    void reset();
+    bool contains(Cell cell) const {
+        return cell.x >= 0 && cell.y >= 0 && cell.x < width && cell.y < height;
+    }
+    bool test(Cell cell) const {
+        size_t i = index(cell);
+        return (words[i >> 6] >> (i & 63)) & 1u;
+    }
+    void set(Cell cell);
+    void clear(Cell cell);
+    size_t getFreeCount() const { return freeCount; }
+    // Bitų laukas (getWordCount() žodžių) ir laisvų langelių medis (getWordCount() + 1 elementų),
+    // kad būseną būtų galima nukopijuoti be perskaičiavimo (Snapshot.h)
+    const uint64_t* getWords() const { return words.data(); }
+    const uint32_t* getFreeTree() const { return freeTree.data(); }
+    size_t getWordCount() const { return words.size(); }
+    void assign(const uint64_t* sourceWords, const uint32_t* sourceTree, size_t sourceFreeCount);
+    // n-tasis laisvas langelis eilutėmis, 0 <= n < getFreeCount()
+    Cell getFreeCell(size_t n) const;
+};
+
+#endif // OCCUPANCYGRID_H
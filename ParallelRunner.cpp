@@ -0,0 +1,60 @@
+#include "ParallelRunner.h"
+#include <algorithm>
+#include <mutex>
+
+// How many ticks each chunk runs per round; rounds keep every chunk at the same tick count
+const int TICKS_PER_TASK = 32;
+
+ParallelRunner::ParallelRunner(BatchSnakeEnv& env, ThreadPool& pool, size_t chunkSize)
+    : env(env), pool(pool), chunkSize(chunkSize > 0 ? chunkSize : 1), actions(env.size()) {
+}
+
+void ParallelRunner::step(const Direction* actions) {
+    for (size_t begin = 0; begin < env.size(); begin += chunkSize) {
+        size_t end = std::min(begin + chunkSize, env.size());
+        pool.submit([this, actions, begin, end] { env.step(actions, begin, end); });
+    }
+    pool.wait();
+}
+
+RunStats ParallelRunner::runEpisodes(const Policy& policy, uint64_t episodes) {
+    env.setAutoReset(true);
+    std::mutex statsMutex;
+    RunStats stats{0, 0, 0, 0};
+
+    // The run goes in rounds: every chunk plays TICKS_PER_TASK ticks, then all are joined. A task that
+    // queued itself again would land on its own worker's LIFO end and starve the chunks behind it,
+    // so episodes would come mostly from a few chunks. Within a round idle workers still steal.
+    auto playChunk = [&](size_t begin, size_t end) {
+        RunStats local{0, 0, 0, 0};
+        for (int tick = 0; tick < TICKS_PER_TASK; ++tick) {
+            for (size_t game = begin; game < end; ++game) {
+                actions[game] = policy(env, game);
+            }
+            env.step(actions.data(), begin, end);
+            local.ticks += end - begin;
+            for (size_t game = begin; game < end; ++game) {
+                if (env.isGameOver(game)) {
+                    ++local.episodes;
+                    local.totalScore += env.getScore(game);
+                    local.bestScore = std::max(local.bestScore, env.getScore(game));
+                }
+            }
+        }
+        std::lock_guard<std::mutex> lock(statsMutex);
+        stats.ticks += local.ticks;
+        stats.episodes += local.episodes;
+        stats.totalScore += local.totalScore;
+        stats.bestScore = std::max(stats.bestScore, local.bestScore);
+    };
+
+    while (stats.episodes < episodes) {
+        for (size_t begin = 0; begin < env.size(); begin += chunkSize) {
+            size_t end = std::min(begin + chunkSize, env.size());
+            pool.submit([&playChunk, begin, end] { playChunk(begin, end); });
+        }
+        pool.wait();
+    }
+    env.setAutoReset(false);
+    return stats;
+}
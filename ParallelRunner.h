@@ -0,0 +1,37 @@
+#ifndef PARALLELRUNNER_H
+#define PARALLELRUNNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "BatchSnakeEnv.h"
+#include "ThreadPool.h"
+
+// Suvestinė po runEpisodes()
+struct RunStats {
+    uint64_t ticks;
+    uint64_t episodes;
+    int64_t totalScore;
+    int bestScore;
+};
+
+// Sprendžia, kur suks gyvatė nurodytame žaidime; turi būti saugi kviesti iš kelių gijų
+using Policy = std::function<Direction(const BatchSnakeEnv& env, size_t game)>;
+
+// Paskirsto BatchSnakeEnv žaidimus gijų telkiniui dalimis po chunkSize žaidimų
+class ParallelRunner {
+private:
+    BatchSnakeEnv& env;
+    ThreadPool& pool;
+    size_t chunkSize;
+    std::vector<Direction> actions;
+public:
+    ParallelRunner(BatchSnakeEnv& env, ThreadPool& pool, size_t chunkSize = 256);
+    // Vienas žingsnis visiems žaidimams, dalys vykdomos lygiagrečiai
+    void step(const Direction* actions);
+    // Žaidžia su automatiniu perkrovimu, kol bus baigta bent episodes epizodų
+    RunStats runEpisodes(const Policy& policy, uint64_t episodes);
+};
+
+#endif // PARALLELRUNNER_H
@@ -0,0 +1,28 @@
+#include "PickingSystem.h"
+#include <algorithm>
+
+PickingSystem::PickingSystem(int width, int height)
+    : width(width), height(height), cells(static_cast<size_t>(width) * height, NO_ENTITY) {
+}
+
+void PickingSystem::update(const EntityStore& store) {
+    std::fill(cells.begin(), cells.end(), NO_ENTITY);
+    const EntityId* entities = store.getEntities();
+    const uint8_t* flags = store.getFlags();
+    const Cell* positions = store.getPositions();
+    for (size_t i = 0; i < store.size(); ++i) {
+        Cell cell = positions[i];
+        if ((flags[i] & HAS_PICKABLE) && static_cast<unsigned>(cell.x) < static_cast<unsigned>(width) &&
+            static_cast<unsigned>(cell.y) < static_cast<unsigned>(height)) {
+            cells[static_cast<size_t>(cell.y) * width + cell.x] = entities[i];
+        }
+    }
+}
+
+EntityId PickingSystem::at(Cell cell) const {
+    if (static_cast<unsigned>(cell.x) >= static_cast<unsigned>(width) ||
+        static_cast<unsigned>(cell.y) >= static_cast<unsigned>(height)) {
+        return NO_ENTITY;
+    }
+    return cells[static_cast<size_t>(cell.y) * width + cell.x];
+}
@@ -0,0 +1,21 @@
+#ifndef PICKINGSYSTEM_H
+#define PICKINGSYSTEM_H
+
+#include <vector>
+#include "EntityStore.h"
+
+// Pelės žymeklio sistema: vienu tiesiniu perėjimu per Pickable komponentus sudaro langelių lentelę,
+// kuri per O(1) atsako, koks piešimo talpyklos subjektas stovi langelyje (ArenaViewer būsenos eilutei).
+// Žaidimo taisyklių susidūrimų ji netikrina - tai daro Simulation ir Arena
+class PickingSystem {
+private:
+    int width;
+    int height;
+    std::vector<EntityId> cells; // subjektas kiekviename langelyje arba NO_ENTITY
+public:
+    PickingSystem(int width, int height);
+    void update(const EntityStore& store);
+    EntityId at(Cell cell) const;
+};
+
+#endif // PICKINGSYSTEM_H
@@ -0,0 +1,51 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+// Skaitliku pagrįstas atsitiktinių skaičių generatorius: n-tasis skaičius yra mix(key + n * GAMMA),
+// taigi visa būsena - du 64 bitų skaičiai. Kiekvienas žaidimas turi savo srautą (key),
+// todėl lygiagretūs žaidimai nesidalija jokia bendra būsena ir yra atkuriami.
+class Random {
+public:
+    struct State {
+        uint64_t key;
+        uint64_t counter;
+    };
+
+    explicit Random(uint64_t seed = 0, uint64_t stream = 0) : state{makeKey(seed, stream), 0} {}
+
+    uint64_t next() {
+        return at(state.key, ++state.counter);
+    }
+
+    // Tolygiai pasiskirstęs skaičius intervale [0, bound)
+    uint32_t below(uint32_t bound) {
+        return static_cast<uint32_t>(((next() >> 32) * bound) >> 32);
+    }
+
+    State getState() const { return state; }
+    void setState(State newState) { state = newState; }
+
+    static uint64_t makeKey(uint64_t seed, uint64_t stream) {
+        return mix(seed ^ mix(stream + GAMMA));
+    }
+
+    // n-tasis srauto key skaičius be generatoriaus: bet kurį galima gauti tiesiogiai, be lentelės
+    static uint64_t at(uint64_t key, uint64_t n) {
+        return mix(key + n * GAMMA);
+    }
+
+private:
+    static const uint64_t GAMMA = 0x9E3779B97F4A7C15ull;
+    State state;
+
+    // SplitMix64 maišymo funkcija
+    static uint64_t mix(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif // RANDOM_H
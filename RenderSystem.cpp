@@ -0,0 +1,32 @@
+#include "RenderSystem.h"
+
+RenderSystem::RenderSystem(float cellSize) : vertices(sf::Quads), cellSize(cellSize) {
+}
+
+void RenderSystem::update(const EntityStore& store) {
+    const uint8_t* flags = store.getFlags();
+    const Cell* positions = store.getPositions();
+    const Renderable* renderables = store.getRenderables();
+    // Resizing keeps the capacity, so a steady entity count never reallocates
+    vertices.resize(store.size() * 4);
+    size_t used = 0;
+    for (size_t i = 0; i < store.size(); ++i) {
+        if (!(flags[i] & HAS_RENDERABLE)) {
+            continue;
+        }
+        float left = positions[i].x * cellSize;
+        float top = positions[i].y * cellSize;
+        sf::Color color(renderables[i].r, renderables[i].g, renderables[i].b, renderables[i].a);
+        sf::Vertex* quad = &vertices[used];
+        quad[0] = sf::Vertex(sf::Vector2f(left, top), color);
+        quad[1] = sf::Vertex(sf::Vector2f(left + cellSize, top), color);
+        quad[2] = sf::Vertex(sf::Vector2f(left + cellSize, top + cellSize), color);
+        quad[3] = sf::Vertex(sf::Vector2f(left, top + cellSize), color);
+        used += 4;
+    }
+    vertices.resize(used);
+}
+
+void RenderSystem::draw(sf::RenderWindow& window) const {
+    window.draw(vertices);
+}
@@ -0,0 +1,19 @@
+#ifndef RENDERSYSTEM_H
+#define RENDERSYSTEM_H
+
+#include <SFML/Graphics.hpp>
+#include "EntityStore.h"
+
+// Piešimo sistema: vienu tiesiniu perėjimu paverčia visus matomus subjektus keturkampiais
+// ir nupiešia juos vienu window.draw() kvietimu
+class RenderSystem {
+private:
+    sf::VertexArray vertices;
+    float cellSize;
+public:
+    explicit RenderSystem(float cellSize);
+    void update(const EntityStore& store);
+    void draw(sf::RenderWindow& window) const;
+};
+
+#endif // RENDERSYSTEM_H
@@ -0,0 +1,82 @@
+#include "Replay.h"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include "Varint.h"
+
+const uint8_t REPLAY_MAGIC[4] = {'S', 'N', 'R', '1'};
+
+Replay::Replay() : width(0), height(0), start{0, 0}, ticks(0), finalScore(0) {
+}
+
+void Replay::encode(std::vector<uint8_t>& out) const {
+    out.insert(out.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    writeVarint(out, static_cast<uint64_t>(width));
+    writeVarint(out, static_cast<uint64_t>(height));
+    writeFixed64(out, start.key);
+    writeVarint(out, start.counter);
+    writeVarint(out, ticks);
+    writeVarint(out, static_cast<uint64_t>(finalScore));
+    writeVarint(out, events.size());
+    uint32_t previousTick = 0;
+    for (const auto& event : events) {
+        // Most changes are a few ticks apart, so one byte usually holds both the gap and the direction
+        writeVarint(out, (static_cast<uint64_t>(event.tick - previousTick) << 2) | event.direction);
+        previousTick = event.tick;
+    }
+}
+
+bool Replay::decode(const uint8_t* data, size_t size) {
+    const uint8_t* end = data + size;
+    if (size < 4 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, data)) {
+        return false;
+    }
+    data += 4;
+
+    uint64_t w, h, counter, tickCount, score, eventCount;
+    if (!readVarint(data, end, w) || !readVarint(data, end, h) || !readFixed64(data, end, start.key) ||
+        !readVarint(data, end, counter) || !readVarint(data, end, tickCount) || !readVarint(data, end, score) ||
+        !readVarint(data, end, eventCount)) {
+        return false;
+    }
+    // The board is built from these before anything else is checked, so they must be usable
+    if (w == 0 || h == 0 || w > MAX_SIDE || h > MAX_SIDE) {
+        return false;
+    }
+    width = static_cast<int>(w);
+    height = static_cast<int>(h);
+    start.counter = counter;
+    ticks = static_cast<uint32_t>(tickCount);
+    finalScore = static_cast<int>(score);
+
+    events.clear();
+    // Every event takes at least one byte, which bounds the reserve for corrupt input
+    events.reserve(eventCount < static_cast<uint64_t>(end - data) ? eventCount : end - data);
+    uint32_t tick = 0;
+    for (uint64_t i = 0; i < eventCount; ++i) {
+        uint64_t packed;
+        if (!readVarint(data, end, packed)) {
+            return false;
+        }
+        tick += static_cast<uint32_t>(packed >> 2);
+        events.push_back(ReplayEvent{tick, static_cast<Direction>(packed & 3)});
+    }
+    return true;
+}
+
+bool Replay::saveToFile(const std::string& filename) const {
+    std::vector<uint8_t> bytes;
+    encode(bytes);
+    std::ofstream file(filename, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool Replay::loadFromFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    return decode(bytes.data(), bytes.size());
+}
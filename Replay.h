@@ -0,0 +1,40 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Random.h"
+#include "Rules.h"
+
+// Krypties pakeitimas: nuo žingsnio tick gyvatė juda kryptimi direction
+struct ReplayEvent {
+    uint32_t tick;
+    Direction direction;
+};
+
+// Įrašyta partija: lentos dydis, atsitiktinių skaičių būsena pradžioje ir krypčių pakeitimai.
+// Viso kito (maisto, kūno, taškų) nereikia saugoti - tai atkuriama iš naujo sužaidžiant partiją.
+class Replay {
+public:
+    int width;
+    int height;
+    Random::State start;
+    uint32_t ticks; // kiek žingsnių truko partija
+    int finalScore; // tikrinimui atkūrus
+    std::vector<ReplayEvent> events;
+
+    // Didžiausia lentos kraštinė, kurią priima decode(); sugadintas failas neturi išskirti gigabaitų
+    static constexpr uint64_t MAX_SIDE = 4096;
+
+    Replay();
+    // Dvejetainis formatas: antraštė ir įvykiai kaip varint((žingsnių skirtumas << 2) | kryptis)
+    void encode(std::vector<uint8_t>& out) const;
+    // false, jei duomenys sugadinti arba lentos dydis ne 1..MAX_SIDE
+    bool decode(const uint8_t* data, size_t size);
+    bool saveToFile(const std::string& filename) const;
+    bool loadFromFile(const std::string& filename);
+};
+
+#endif // REPLAY_H
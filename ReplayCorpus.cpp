@@ -0,0 +1,138 @@
+#include "ReplayCorpus.h"
+#include <algorithm>
+#include <cstring>
+#include "Keyframe.h"
+#include "Varint.h"
+
+#if defined(_WIN32)
+#include <fstream>
+#include <iterator>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+ReplayCorpus::ReplayCorpus() : data(nullptr), size(0), keyframeInterval(0), episodeCount(0), indexOffset(0) {
+}
+
+ReplayCorpus::~ReplayCorpus() {
+    close();
+}
+
+bool ReplayCorpus::openFromFile(const std::string& filename) {
+    close();
+#if defined(_WIN32)
+    // No mmap here: read the whole file instead
+    std::ifstream file(filename, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint8_t* copy = new uint8_t[bytes.size() > 0 ? bytes.size() : 1];
+    std::copy(bytes.begin(), bytes.end(), copy);
+    data = copy;
+    size = bytes.size();
+#else
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(CORPUS_HEADER_SIZE)) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    data = static_cast<const uint8_t*>(mapped);
+    size = static_cast<size_t>(info.st_size);
+#endif
+
+    const uint8_t* p = data + 8;
+    const uint8_t* end = data + size;
+    if (size < CORPUS_HEADER_SIZE || std::memcmp(data, "SNC1", 4) != 0 || !readFixed64(p, end, keyframeInterval) ||
+        !readFixed64(p, end, episodeCount) || !readFixed64(p, end, indexOffset) || keyframeInterval == 0 ||
+        indexOffset > size || episodeCount > (size - indexOffset) / CORPUS_INDEX_ENTRY_SIZE) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ReplayCorpus::close() {
+    if (data) {
+#if defined(_WIN32)
+        delete[] data;
+#else
+        munmap(const_cast<uint8_t*>(data), size);
+#endif
+    }
+    data = nullptr;
+    size = 0;
+    keyframeInterval = 0;
+    episodeCount = 0;
+    indexOffset = 0;
+}
+
+bool ReplayCorpus::readEntry(size_t episode, CorpusIndexEntry& entry) const {
+    if (episode >= episodeCount) {
+        return false;
+    }
+    const uint8_t* p = data + indexOffset + episode * CORPUS_INDEX_ENTRY_SIZE;
+    const uint8_t* end = data + size;
+    return readFixed64(p, end, entry.replayOffset) && readFixed64(p, end, entry.replaySize) &&
+           readFixed64(p, end, entry.keyframeTableOffset) && readFixed64(p, end, entry.keyframeCount) &&
+           readFixed64(p, end, entry.ticks) && entry.replayOffset <= size &&
+           entry.replaySize <= size - entry.replayOffset && entry.keyframeTableOffset <= size &&
+           entry.keyframeCount <= (size - entry.keyframeTableOffset) / 8;
+}
+
+uint32_t ReplayCorpus::getTicks(size_t episode) const {
+    CorpusIndexEntry entry;
+    return readEntry(episode, entry) ? static_cast<uint32_t>(entry.ticks) : 0;
+}
+
+bool ReplayCorpus::getReplay(size_t episode, Replay& replay) const {
+    CorpusIndexEntry entry;
+    return readEntry(episode, entry) &&
+           replay.decode(data + entry.replayOffset, static_cast<size_t>(entry.replaySize));
+}
+
+bool ReplayCorpus::seek(size_t episode, uint32_t tick, ReplayPlayer& player) const {
+    CorpusIndexEntry entry;
+    if (!readEntry(episode, entry)) {
+        return false;
+    }
+    tick = std::min(tick, static_cast<uint32_t>(entry.ticks));
+
+    // Keyframe k holds the state after (k + 1) * keyframeInterval ticks
+    uint64_t keyframe = tick / keyframeInterval;
+    if (keyframe > entry.keyframeCount) {
+        keyframe = entry.keyframeCount;
+    }
+    // Use the keyframe unless simply playing forward from the current position is shorter
+    uint32_t keyframeTick = static_cast<uint32_t>(keyframe * keyframeInterval);
+    if (keyframe > 0 && (player.getTick() > tick || player.getTick() < keyframeTick)) {
+        const uint8_t* p = data + entry.keyframeTableOffset + (keyframe - 1) * 8;
+        const uint8_t* end = data + size;
+        uint64_t keyframeOffset;
+        if (!readFixed64(p, end, keyframeOffset) || keyframeOffset >= size) {
+            return false;
+        }
+        p = data + keyframeOffset;
+        uint32_t storedTick;
+        SimulationState state;
+        if (!decodeKeyframe(p, end, storedTick, state)) {
+            return false;
+        }
+        player.jumpTo(storedTick, state);
+    }
+    player.seek(tick);
+    return player.getTick() == tick;
+}
@@ -0,0 +1,52 @@
+#ifndef REPLAYCORPUS_H
+#define REPLAYCORPUS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Replay.h"
+#include "ReplayPlayer.h"
+
+// Įrašų rinkinio failas:
+//   antraštė (32 baitai): "SNC1", rakto kadrų intervalas, epizodų skaičius, rodyklės poslinkis;
+//   kiekvienam epizodui - Replay baitai, rakto kadrai ir jų poslinkių lentelė;
+//   rodyklė - po CORPUS_INDEX_ENTRY_SIZE baitų kiekvienam epizodui, todėl epizodas randamas per O(1).
+// Visi fiksuoto dydžio laukai yra 64 bitų little-endian.
+const size_t CORPUS_HEADER_SIZE = 32;
+const size_t CORPUS_INDEX_ENTRY_SIZE = 40;
+
+// Vienas rodyklės įrašas
+struct CorpusIndexEntry {
+    uint64_t replayOffset;
+    uint64_t replaySize;
+    uint64_t keyframeTableOffset; // keyframeCount poslinkių; k-tasis kadras yra po (k + 1) * intervalas žingsnių
+    uint64_t keyframeCount;
+    uint64_t ticks;
+};
+
+// Skaito įrašų rinkinį, atvaizduotą į atmintį (mmap): failas neperskaitomas, nuskaitomi tik reikalingi puslapiai
+class ReplayCorpus {
+private:
+    const uint8_t* data;
+    size_t size;
+    uint64_t keyframeInterval;
+    uint64_t episodeCount;
+    uint64_t indexOffset;
+    bool readEntry(size_t episode, CorpusIndexEntry& entry) const;
+public:
+    ReplayCorpus();
+    ~ReplayCorpus();
+    ReplayCorpus(const ReplayCorpus&) = delete;
+    ReplayCorpus& operator=(const ReplayCorpus&) = delete;
+    bool openFromFile(const std::string& filename);
+    void close();
+    size_t getEpisodeCount() const { return static_cast<size_t>(episodeCount); }
+    uint32_t getKeyframeInterval() const { return static_cast<uint32_t>(keyframeInterval); }
+    uint32_t getTicks(size_t episode) const;
+    bool getReplay(size_t episode, Replay& replay) const;
+    // Perkelia player (sukurtą šio epizodo įrašui) į žingsnį tick: artimiausias ankstesnis rakto kadras
+    // ir ne daugiau kaip intervalas žingsnių simuliacijos
+    bool seek(size_t episode, uint32_t tick, ReplayPlayer& player) const;
+};
+
+#endif // REPLAYCORPUS_H
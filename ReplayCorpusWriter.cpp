@@ -0,0 +1,79 @@
+#include "ReplayCorpusWriter.h"
+#include "Keyframe.h"
+#include "ReplayPlayer.h"
+#include "Varint.h"
+
+const uint8_t CORPUS_MAGIC[8] = {'S', 'N', 'C', '1', 0, 0, 0, 0};
+
+ReplayCorpusWriter::ReplayCorpusWriter(uint32_t keyframeInterval)
+    : keyframeInterval(keyframeInterval > 0 ? keyframeInterval : 1), offset(0) {
+}
+
+bool ReplayCorpusWriter::open(const std::string& filename) {
+    file.open(filename, std::ios::binary | std::ios::trunc);
+    index.clear();
+    // Placeholder header; close() rewrites it once the index position is known
+    write(std::vector<uint8_t>(CORPUS_HEADER_SIZE, 0));
+    offset = CORPUS_HEADER_SIZE;
+    return static_cast<bool>(file);
+}
+
+void ReplayCorpusWriter::write(const std::vector<uint8_t>& bytes) {
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    offset += bytes.size();
+}
+
+bool ReplayCorpusWriter::add(const Replay& replay) {
+    CorpusIndexEntry entry;
+    entry.ticks = replay.ticks;
+
+    std::vector<uint8_t> bytes;
+    replay.encode(bytes);
+    entry.replayOffset = offset;
+    entry.replaySize = bytes.size();
+    write(bytes);
+
+    // Replay the game once and store the full state every keyframeInterval ticks
+    std::vector<uint64_t> keyframeOffsets;
+    ReplayPlayer player(replay);
+    for (uint32_t tick = keyframeInterval; tick <= replay.ticks; tick += keyframeInterval) {
+        player.seek(tick);
+        bytes.clear();
+        encodeKeyframe(bytes, tick, player.getSimulation().getState());
+        keyframeOffsets.push_back(offset);
+        write(bytes);
+    }
+
+    bytes.clear();
+    for (uint64_t keyframeOffset : keyframeOffsets) {
+        writeFixed64(bytes, keyframeOffset);
+    }
+    entry.keyframeTableOffset = offset;
+    entry.keyframeCount = keyframeOffsets.size();
+    write(bytes);
+
+    index.push_back(entry);
+    return static_cast<bool>(file);
+}
+
+bool ReplayCorpusWriter::close() {
+    uint64_t indexOffset = offset;
+    std::vector<uint8_t> bytes;
+    for (const auto& entry : index) {
+        writeFixed64(bytes, entry.replayOffset);
+        writeFixed64(bytes, entry.replaySize);
+        writeFixed64(bytes, entry.keyframeTableOffset);
+        writeFixed64(bytes, entry.keyframeCount);
+        writeFixed64(bytes, entry.ticks);
+    }
+    write(bytes);
+
+    bytes.assign(CORPUS_MAGIC, CORPUS_MAGIC + 8);
+    writeFixed64(bytes, keyframeInterval);
+    writeFixed64(bytes, index.size());
+    writeFixed64(bytes, indexOffset);
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    file.close();
+    return !file.fail();
+}
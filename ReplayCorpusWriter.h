@@ -0,0 +1,27 @@
+#ifndef REPLAYCORPUSWRITER_H
+#define REPLAYCORPUSWRITER_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Replay.h"
+#include "ReplayCorpus.h"
+
+// Rašo įrašų rinkinį (formatas aprašytas ReplayCorpus.h); rakto kadrai sukuriami atkuriant kiekvieną partiją
+class ReplayCorpusWriter {
+private:
+    std::ofstream file;
+    uint32_t keyframeInterval;
+    uint64_t offset;
+    std::vector<CorpusIndexEntry> index;
+    void write(const std::vector<uint8_t>& bytes);
+public:
+    explicit ReplayCorpusWriter(uint32_t keyframeInterval = 256);
+    bool open(const std::string& filename);
+    bool add(const Replay& replay);
+    // Įrašo rodyklę ir antraštę; be šio kvietimo failas neskaitomas
+    bool close();
+};
+
+#endif // REPLAYCORPUSWRITER_H
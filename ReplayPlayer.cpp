@@ -0,0 +1,54 @@
+#include "ReplayPlayer.h"
+#include <algorithm>
+
+ReplayPlayer::ReplayPlayer(const Replay& replay)
+    : replay(replay), simulation(replay.width, replay.height), nextEvent(0), tick(0) {
+    restart();
+}
+
+void ReplayPlayer::restart() {
+    simulation.reset(replay.start);
+    direction = simulation.getDirection();
+    nextEvent = 0;
+    tick = 0;
+}
+
+void ReplayPlayer::seek(uint32_t targetTick) {
+    if (targetTick < tick) {
+        restart();
+    }
+    while (tick < targetTick && step()) {
+    }
+}
+
+void ReplayPlayer::jumpTo(uint32_t tick, const SimulationState& state) {
+    simulation.setState(state);
+    this->tick = tick;
+    direction = state.direction;
+    // The next step to play is number tick, so skip every change recorded before it
+    nextEvent = std::lower_bound(replay.events.begin(), replay.events.end(), tick,
+                                 [](const ReplayEvent& event, uint32_t value) { return event.tick < value; }) -
+                replay.events.begin();
+}
+
+bool ReplayPlayer::step() {
+    if (tick >= replay.ticks) {
+        return false;
+    }
+    if (nextEvent < replay.events.size() && replay.events[nextEvent].tick == tick) {
+        direction = replay.events[nextEvent].direction;
+        ++nextEvent;
+    }
+    simulation.step(direction);
+    ++tick;
+    return true;
+}
+
+void ReplayPlayer::runToEnd() {
+    while (step()) {
+    }
+}
+
+bool ReplayPlayer::matchesRecording() const {
+    return tick == replay.ticks && simulation.getScore() == replay.finalScore;
+}
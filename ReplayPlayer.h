@@ -0,0 +1,35 @@
+#ifndef REPLAYPLAYER_H
+#define REPLAYPLAYER_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Replay.h"
+#include "Simulation.h"
+
+// Atkuria įrašytą partiją be lango, žingsnis po žingsnio arba iškart iki galo
+class ReplayPlayer {
+private:
+    const Replay& replay;
+    Simulation simulation;
+    size_t nextEvent;
+    uint32_t tick;
+    Direction direction;
+public:
+    explicit ReplayPlayer(const Replay& replay);
+    // Grąžina false, kai įrašas baigėsi
+    bool step();
+    void runToEnd();
+    // Grįžta į partijos pradžią
+    void restart();
+    // Pereina į nurodytą žingsnį, prireikus pradėdamas iš naujo; vėlesnis žingsnis pasiekiamas simuliuojant
+    void seek(uint32_t targetTick);
+    // Peršoka į išsaugotą būseną po tick žingsnių (pvz. iš ReplayCorpus rakto kadro)
+    void jumpTo(uint32_t tick, const SimulationState& state);
+    uint32_t getTick() const { return tick; }
+    const Replay& getReplay() const { return replay; }
+    const Simulation& getSimulation() const { return simulation; }
+    // Ar atkurta partija baigėsi taip pat, kaip įrašyta
+    bool matchesRecording() const;
+};
+
+#endif // REPLAYPLAYER_H
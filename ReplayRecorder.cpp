@@ -0,0 +1,22 @@
+#include "ReplayRecorder.h"
+
+ReplayRecorder::ReplayRecorder() : lastDirection(RIGHT) {
+}
+
+void ReplayRecorder::start(const Simulation& simulation) {
+    replay = Replay();
+    replay.width = simulation.getWidth();
+    replay.height = simulation.getHeight();
+    replay.start = simulation.getStartState();
+    lastDirection = simulation.getDirection();
+}
+
+void ReplayRecorder::record(const Simulation& simulation) {
+    // Only the direction actually taken is stored; ignored reversals and repeated keys cost nothing
+    if (simulation.getDirection() != lastDirection) {
+        lastDirection = simulation.getDirection();
+        replay.events.push_back(ReplayEvent{replay.ticks, lastDirection});
+    }
+    ++replay.ticks;
+    replay.finalScore = simulation.getScore();
+}
@@ -0,0 +1,19 @@
+#ifndef REPLAYRECORDER_H
+#define REPLAYRECORDER_H
+
+#include "Replay.h"
+#include "Simulation.h"
+
+// Įrašo partiją: kviesti start() po Simulation::reset() ir record() po kiekvieno Simulation::step()
+class ReplayRecorder {
+private:
+    Replay replay;
+    Direction lastDirection;
+public:
+    ReplayRecorder();
+    void start(const Simulation& simulation);
+    void record(const Simulation& simulation);
+    const Replay& getReplay() const { return replay; }
+};
+
+#endif // REPLAYRECORDER_H
@@ -0,0 +1,101 @@
+#include "ReplayViewer.h"
+#include <algorithm>
+#include <iostream>
+
+const long long PAGE_TICKS = 100;
+
+ReplayViewer::ReplayViewer(const std::string& filename)
+    : window(sf::VideoMode(GameBoard::PIXEL_WIDTH, GameBoard::PIXEL_HEIGHT), "Snake Replay"), episode(0), playing(false) {
+    window.setFramerateLimit(30);
+    if (!font.loadFromFile("../resources/arial.ttf")) {
+        std::cerr << "Could not load font!" << std::endl;
+    }
+    statusText.setFont(font);
+    statusText.setCharacterSize(18);
+    statusText.setFillColor(sf::Color::White);
+    statusText.setPosition(10, 10);
+
+    if (!corpus.openFromFile(filename) || corpus.getEpisodeCount() == 0) {
+        std::cerr << "Could not open replay corpus " << filename << std::endl;
+        window.close();
+        return;
+    }
+    openEpisode(0);
+}
+
+void ReplayViewer::openEpisode(size_t newEpisode) {
+    // The renderer and player refer to the replay, so drop them before it is replaced
+    renderer.reset();
+    player.reset();
+    if (!corpus.getReplay(newEpisode, replay)) {
+        std::cerr << "Could not read episode " << newEpisode << std::endl;
+        window.close();
+        return;
+    }
+    episode = newEpisode;
+    player = std::make_unique<ReplayPlayer>(replay);
+    renderer = std::make_unique<BoardRenderer>(player->getSimulation());
+}
+
+void ReplayViewer::seek(long long tick) {
+    if (tick < 0) {
+        tick = 0;
+    }
+    corpus.seek(episode, static_cast<uint32_t>(std::min<long long>(tick, replay.ticks)), *player);
+    renderer->invalidate();
+}
+
+void ReplayViewer::run() {
+    while (window.isOpen()) {
+        handleEvents();
+        if (!window.isOpen()) {
+            break;
+        }
+        if (playing && !player->step()) {
+            playing = false;
+        }
+        render();
+    }
+}
+
+void ReplayViewer::handleEvents() {
+    sf::Event event;
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        } else if (event.type == sf::Event::KeyPressed && player) {
+            long long tick = player->getTick();
+            switch (event.key.code) {
+                case sf::Keyboard::Space: playing = !playing; break;
+                case sf::Keyboard::Right: seek(tick + 1); break;
+                case sf::Keyboard::Left: seek(tick - 1); break;
+                case sf::Keyboard::PageDown: seek(tick + PAGE_TICKS); break;
+                case sf::Keyboard::PageUp: seek(tick - PAGE_TICKS); break;
+                case sf::Keyboard::Home: seek(0); break;
+                case sf::Keyboard::End: seek(replay.ticks); break;
+                case sf::Keyboard::Down:
+                    if (episode + 1 < corpus.getEpisodeCount()) {
+                        openEpisode(episode + 1);
+                    }
+                    break;
+                case sf::Keyboard::Up:
+                    if (episode > 0) {
+                        openEpisode(episode - 1);
+                    }
+                    break;
+                case sf::Keyboard::Q: window.close(); break;
+                default: break;
+            }
+        }
+    }
+}
+
+void ReplayViewer::render() {
+    window.clear();
+    renderer->draw(window);
+    statusText.setString("Episode " + std::to_string(episode + 1) + "/" + std::to_string(corpus.getEpisodeCount()) +
+                         "  Tick " + std::to_string(player->getTick()) + "/" + std::to_string(replay.ticks) +
+                         "  Score " + std::to_string(player->getSimulation().getScore()));
+    window.draw(statusText);
+    window.display();
+}
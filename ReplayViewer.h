@@ -0,0 +1,33 @@
+#ifndef REPLAYVIEWER_H
+#define REPLAYVIEWER_H
+
+#include <SFML/Graphics.hpp>
+#include <memory>
+#include <string>
+#include "BoardRenderer.h"
+#include "Replay.h"
+#include "ReplayCorpus.h"
+#include "ReplayPlayer.h"
+
+// Įrašų rinkinio peržiūra: epizodų perjungimas ir greitas slinkimas po partiją naudojant rakto kadrus
+class ReplayViewer {
+private:
+    sf::RenderWindow window;
+    ReplayCorpus corpus;
+    size_t episode;
+    Replay replay;
+    std::unique_ptr<ReplayPlayer> player;
+    std::unique_ptr<BoardRenderer> renderer;
+    bool playing;
+    sf::Font font;
+    sf::Text statusText;
+    void openEpisode(size_t newEpisode);
+    void seek(long long tick);
+    void handleEvents();
+    void render();
+public:
+    explicit ReplayViewer(const std::string& filename);
+    void run();
+};
+
+#endif // REPLAYVIEWER_H
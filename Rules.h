@@ -0,0 +1,47 @@
+#ifndef RULES_H
+#define RULES_H
+
+#include "Cell.h"
+
+// Taisyklės, bendros Simulation ir BatchSnakeEnv klasėms
+
+const int SCORE_PER_FOOD = 10;
+const int GROWTH_PER_FOOD = 2; // per kiek žingsnių gyvatė pailgėja suvalgiusi maistą
+
+// Priešingų krypčių reikšmės skiriasi tik mažiausiu bitu (UP^DOWN == LEFT^RIGHT == 1)
+enum Direction { UP, DOWN, LEFT, RIGHT };
+
+// Gyvatė negali apsisukti atgal; tokia komanda ignoruojama
+inline Direction applyTurn(Direction current, Direction requested) {
+    return (current ^ requested) == 1 ? current : requested;
+}
+
+inline int directionDx(Direction direction) {
+    return (direction == RIGHT) - (direction == LEFT);
+}
+
+inline int directionDy(Direction direction) {
+    return (direction == DOWN) - (direction == UP);
+}
+
+inline Direction oppositeDirection(Direction direction) {
+    return static_cast<Direction>(direction ^ 1);
+}
+
+inline Cell moveCell(Cell cell, Direction direction) {
+    return Cell{cell.x + directionDx(direction), cell.y + directionDy(direction)};
+}
+
+// Kryptis tarp dviejų gretimų langelių
+inline Direction directionBetween(Cell from, Cell to) {
+    if (to.x > from.x) {
+        return RIGHT;
+    } else if (to.x < from.x) {
+        return LEFT;
+    } else if (to.y > from.y) {
+        return DOWN;
+    }
+    return UP;
+}
+
+#endif // RULES_H
@@ -0,0 +1,205 @@
+#include "Simulation.h"
+#include "Tracer.h"
+
+Simulation::Simulation(int width, int height, uint64_t seed)
+    : width(width), height(height), occupied(width, height), random(seed), zobrist(width, height),
+      hash(0) {
+    reset();
+}
+
+void Simulation::reset(uint64_t seed) {
+    random = Random(seed);
+    reset();
+}
+
+void Simulation::reset(Random::State state) {
+    random.setState(state);
+    reset();
+}
+
+void Simulation::reset() {
+    startState = random.getState();
+    body.clear();
+    occupied.reset();
+    Cell start{width / 2, height / 2};
+    body.pushFront(start);
+    occupied.set(start);
+    direction = RIGHT;
+    pendingGrowth = 0;
+    score = 0;
+    gameOver = false;
+    won = false;
+    regenerateFood();
+    computeHash();
+}
+
+StepResult Simulation::step(Direction action) {
+    StepResult result{false, gameOver, won};
+    if (gameOver) {
+        return result;
+    }
+
+    Direction previousDirection = direction;
+    int previousGrowth = pendingGrowth;
+    Cell previousHead = body.front();
+    // Collected locally and applied once, so the occupancy writes do not force the member to be reloaded
+    const Zobrist& keys = zobrist;
+    uint64_t hashChange = keys.head(previousHead);
+    direction = applyTurn(direction, action);
+    Cell head = moveCell(previousHead, direction);
+
+    if (head == food) {
+        pendingGrowth += GROWTH_PER_FOOD;
+        score += SCORE_PER_FOOD;
+        result.ateFood = true;
+    }
+
+    // The tail is released before the collision check, so the head may enter the cell it frees
+    if (pendingGrowth > 0) {
+        --pendingGrowth;
+    } else {
+        hashChange ^= keys.body(body.back());
+        occupied.clear(body.back());
+        body.popBack();
+    }
+
+    if (!occupied.contains(head) || occupied.test(head)) {
+        gameOver = true;
+    } else {
+        occupied.set(head);
+        hashChange ^= keys.body(head);
+    }
+    // Turns and growth changes are rare, so their keys are only read when they change
+    hashChange ^= keys.head(head);
+    if (direction != previousDirection) {
+        hashChange ^= keys.direction(previousDirection) ^ keys.direction(direction);
+    }
+    if (pendingGrowth != previousGrowth) {
+        hashChange ^= keys.growth(previousGrowth) ^ keys.growth(pendingGrowth);
+    }
+    hash ^= hashChange;
+    body.pushFront(direction);
+
+    if (result.ateFood && !gameOver) {
+        regenerateFood();
+    }
+    result.gameOver = gameOver;
+    result.won = won;
+    return result;
+}
+
+void Simulation::regenerateFood() {
+    TraceScope trace("Simulation::regenerateFood");
+    hash ^= zobrist.food(food);
+    if (occupied.getFreeCount() == 0) {
+        // No room left for food: the snake has filled the board
+        food = Cell{-1, -1};
+        won = true;
+        gameOver = true;
+        return;
+    }
+    food = occupied.getFreeCell(random.below(static_cast<uint32_t>(occupied.getFreeCount())));
+    hash ^= zobrist.food(food);
+}
+
+void Simulation::computeHash() {
+    hash = 0;
+    for (int y = 0; y < height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (occupied.test(Cell{x, y})) {
+                hash ^= zobrist.body(Cell{x, y});
+            }
+        }
+    }
+    if (!body.empty()) {
+        hash ^= zobrist.head(body.front());
+    }
+    hash ^= zobrist.direction(direction) ^ zobrist.growth(pendingGrowth) ^ zobrist.food(food);
+}
+
+int Simulation::getWidth() const {
+    return width;
+}
+
+int Simulation::getHeight() const {
+    return height;
+}
+
+const SnakeBody& Simulation::getBody() const {
+    return body;
+}
+
+Cell Simulation::getHead() const {
+    return body.front();
+}
+
+Direction Simulation::getDirection() const {
+    return direction;
+}
+
+Cell Simulation::getFood() const {
+    return food;
+}
+
+bool Simulation::isFree(Cell cell) const {
+    return occupied.contains(cell) && !occupied.test(cell);
+}
+
+int Simulation::getPendingGrowth() const {
+    return pendingGrowth;
+}
+
+int Simulation::getScore() const {
+    return score;
+}
+
+bool Simulation::isGameOver() const {
+    return gameOver;
+}
+
+bool Simulation::isWon() const {
+    return won;
+}
+
+Random::State Simulation::getRandomState() const {
+    return random.getState();
+}
+
+Random::State Simulation::getStartState() const {
+    return startState;
+}
+
+SimulationState Simulation::getState() const {
+    SimulationState state;
+    state.body.assign(body.begin(), body.end());
+    state.direction = direction;
+    state.food = food;
+    state.pendingGrowth = pendingGrowth;
+    state.score = score;
+    state.gameOver = gameOver;
+    state.won = won;
+    state.random = random.getState();
+    state.start = startState;
+    return state;
+}
+
+void Simulation::setState(const SimulationState& state) {
+    body.clear();
+    occupied.reset();
+    for (auto it = state.body.rbegin(); it != state.body.rend(); ++it) {
+        body.pushFront(*it);
+        // After a fatal step the head may be off the board
+        if (occupied.contains(*it)) {
+            occupied.set(*it);
+        }
+    }
+    direction = state.direction;
+    food = state.food;
+    pendingGrowth = state.pendingGrowth;
+    score = state.score;
+    gameOver = state.gameOver;
+    won = state.won;
+    random.setState(state.random);
+    startState = state.start;
+    computeHash();
+}
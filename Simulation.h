@@ -0,0 +1,145 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <cstring>
+#include <vector>
+#include "Board.h"
+#include "Cell.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+#include "Rules.h"
+#include "SnakeBody.h"
+#include "Snapshot.h"
+#include "Zobrist.h"
+
+// Vieno žingsnio rezultatas
+struct StepResult {
+    bool ateFood;
+    bool gameOver;
+    bool won; // gyvatė užpildė visą lentą
+};
+
+// Visa simuliacijos būsena, kurią galima išsaugoti ir vėliau atkurti
+struct SimulationState {
+    std::vector<Cell> body; // nuo galvos iki uodegos
+    Direction direction;
+    Cell food;
+    int pendingGrowth;
+    int score;
+    bool gameOver;
+    bool won;
+    Random::State random;
+    Random::State start;
+};
+
+// Žaidimo taisyklės be SFML lango ir laikrodžio, kad žaidimą būtų galima vykdyti greičiau nei realiu laiku
+class Simulation {
+private:
+    int width;
+    int height;
+    SnakeBody body; // auga pagal poreikį, todėl didelei lentai iš anksto neišskiriama atmintis
+    OccupancyGrid occupied; // kurie langeliai užimti kūno
+    Direction direction;
+    Cell food;
+    int pendingGrowth; // kiek žingsnių uodega dar nepatrumpės
+    int score;
+    bool gameOver;
+    bool won;
+    Random random; // šio žaidimo atsitiktinių skaičių srautas maisto vietai
+    Random::State startState; // srauto būsena partijos pradžioje, iš kurios ją galima atkurti
+    Zobrist zobrist;
+    uint64_t hash; // atnaujinama kiekviename žingsnyje
+    void regenerateFood();
+    void computeHash(); // iš naujo, per O(langelių)
+public:
+    Simulation(int width = GameBoard::WIDTH, int height = GameBoard::HEIGHT, uint64_t seed = 0);
+    // Nauja partija; atsitiktinių skaičių srautas tęsiamas
+    void reset();
+    // Nauja partija su nauju srautu, kad ją būtų galima tiksliai atkurti
+    void reset(uint64_t seed);
+    // Nauja partija nuo tikslios srauto būsenos (pvz. getStartState() reikšmės)
+    void reset(Random::State state);
+    StepResult step(Direction action);
+    int getWidth() const;
+    int getHeight() const;
+    const SnakeBody& getBody() const;
+    Cell getHead() const;
+    Direction getDirection() const;
+    Cell getFood() const;
+    // Ar langelis lentoje ir neužimtas gyvatės kūno
+    bool isFree(Cell cell) const;
+    // Užimtumo bitų laukas eilutėmis, kad fiksuoto dydžio lentų kodas (Board<>::test) tikrintų langelius
+    // su kompiliavimo metu žinomu pločiu
+    const uint64_t* getOccupancyWords() const { return occupied.getWords(); }
+    // Kiek dar žingsnių gyvatė augs, nepatrumpindama uodegos
+    int getPendingGrowth() const;
+    int getScore() const;
+    bool isGameOver() const;
+    bool isWon() const;
+    Random::State getRandomState() const;
+    // Pakeičia tik srautą, iš kurio bus renkamas kitas maistas; lenta ir maiša lieka tokios pat
+    void setRandomState(Random::State state) { random.setState(state); }
+    Random::State getStartState() const;
+    // Zobrist maiša: užimti langeliai, galva, kryptis, likęs augimas ir maistas.
+    // Atsitiktinių skaičių būsena neįeina, todėl vienodos lentos su skirtingais srautais sutampa.
+    uint64_t getHash() const { return hash; }
+    SimulationState getState() const;
+    // Būsena turi būti paimta iš tokio pat dydžio lentos
+    void setState(const SimulationState& state);
+    // Greitas būsenos išsaugojimas ir atkūrimas paieškai (žr. Snapshot.h);
+    // grąžina false, jei lentos dydis nesutampa su BoardT
+    template <typename BoardT>
+    bool save(Snapshot<BoardT>& snapshot) const;
+    template <typename BoardT>
+    bool restore(const Snapshot<BoardT>& snapshot);
+};
+
+template <typename BoardT>
+bool Simulation::save(Snapshot<BoardT>& snapshot) const {
+    if (width != BoardT::WIDTH || height != BoardT::HEIGHT ||
+        body.getLinkWordCount() > Snapshot<BoardT>::LINK_WORDS) {
+        return false;
+    }
+    // The ring is copied as it lies in memory; only the words in use are touched
+    std::memcpy(snapshot.links, body.getLinkWords(), body.getLinkWordCount() * sizeof(uint64_t));
+    std::memcpy(snapshot.occupied.data(), occupied.getWords(), sizeof(snapshot.occupied));
+    std::memcpy(snapshot.freeTree, occupied.getFreeTree(), sizeof(snapshot.freeTree));
+    snapshot.freeCount = static_cast<uint32_t>(occupied.getFreeCount());
+    snapshot.linkWords = static_cast<uint32_t>(body.getLinkWordCount());
+    snapshot.headSlot = static_cast<uint32_t>(body.getHeadSlot());
+    snapshot.length = static_cast<uint32_t>(body.size());
+    snapshot.head = body.front();
+    snapshot.tail = body.back();
+    snapshot.food = food;
+    snapshot.direction = direction;
+    snapshot.pendingGrowth = pendingGrowth;
+    snapshot.score = score;
+    snapshot.gameOver = gameOver;
+    snapshot.won = won;
+    snapshot.random = random.getState();
+    snapshot.start = startState;
+    snapshot.hash = hash;
+    return true;
+}
+
+template <typename BoardT>
+bool Simulation::restore(const Snapshot<BoardT>& snapshot) {
+    if (width != BoardT::WIDTH || height != BoardT::HEIGHT) {
+        return false;
+    }
+    body.assign(snapshot.links, snapshot.linkWords, snapshot.headSlot, snapshot.length, snapshot.head,
+                snapshot.tail);
+    occupied.assign(snapshot.occupied.data(), snapshot.freeTree, snapshot.freeCount);
+    food = snapshot.food;
+    direction = snapshot.direction;
+    pendingGrowth = snapshot.pendingGrowth;
+    score = snapshot.score;
+    gameOver = snapshot.gameOver;
+    won = snapshot.won;
+    random.setState(snapshot.random);
+    startState = snapshot.start;
+    hash = snapshot.hash;
+    return true;
+}
+
+#endif // SIMULATION_H
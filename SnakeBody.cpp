@@ -0,0 +1,102 @@
+#include "SnakeBody.h"
+
+static size_t roundUpToPowerOfTwo(size_t n) {
+    size_t capacity = 1;
+    while (capacity < n) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+SnakeBody::SnakeBody(size_t capacity)
+    : capacity(roundUpToPowerOfTwo(capacity < 32 ? 32 : capacity)), head(0), count(0), headCell{0, 0},
+      tailCell{0, 0} {
+    links.resize(this->capacity / 32);
+    mask = this->capacity - 1;
+}
+
+void SnakeBody::setLink(size_t slot, Direction direction) {
+    uint64_t& word = links[slot >> 5];
+    unsigned shift = (slot & 31) * 2;
+    word = (word & ~(uint64_t(3) << shift)) | (uint64_t(direction) << shift);
+}
+
+void SnakeBody::pushFront(Cell cell) {
+    if (count == 0) {
+        headCell = cell;
+        tailCell = cell;
+        count = 1;
+        return;
+    }
+    if (count == capacity) {
+        grow();
+    }
+    // The old head keeps its slot and now records the step the new head took from it
+    setLink(head, directionBetween(headCell, cell));
+    head = (head - 1) & mask;
+    headCell = cell;
+    ++count;
+}
+
+void SnakeBody::pushFront(Direction direction) {
+    if (count == 0) {
+        // A one-segment snake is empty between popBack() and pushFront(); its head cell is still known
+        pushFront(moveCell(headCell, direction));
+        return;
+    }
+    if (count == capacity) {
+        grow();
+    }
+    setLink(head, direction);
+    head = (head - 1) & mask;
+    headCell = moveCell(headCell, direction);
+    ++count;
+}
+
+void SnakeBody::popBack() {
+    --count;
+    if (count > 0) {
+        // The old tail's link points at the segment that becomes the new tail
+        tailCell = moveCell(tailCell, getLink(getSlot(count)));
+    }
+}
+
+void SnakeBody::clear() {
+    head = 0;
+    count = 0;
+}
+
+void SnakeBody::assign(const uint64_t* words, size_t wordCount, size_t headSlot, size_t length, Cell front,
+                       Cell back) {
+    // assign() reuses the vector's storage, so restoring into a body of the same size does not allocate
+    links.assign(words, words + wordCount);
+    capacity = wordCount * 32;
+    mask = capacity - 1;
+    head = headSlot;
+    count = length;
+    headCell = front;
+    tailCell = back;
+}
+
+Cell SnakeBody::operator[](size_t i) const {
+    Cell cell = headCell;
+    for (size_t k = 1; k <= i; ++k) {
+        cell = moveCell(cell, oppositeDirection(getLink(getSlot(k))));
+    }
+    return cell;
+}
+
+void SnakeBody::grow() {
+    // Unwrap into a buffer twice as large so the head starts at slot 0 again
+    SnakeBody larger(capacity * 2);
+    larger.count = count;
+    larger.headCell = headCell;
+    larger.tailCell = tailCell;
+    for (size_t i = 1; i < count; ++i) {
+        larger.setLink(i, getLink(getSlot(i)));
+    }
+    links.swap(larger.links);
+    capacity = larger.capacity;
+    head = 0;
+    mask = capacity - 1;
+}
@@ -0,0 +1,85 @@
+#ifndef SNAKEBODY_H
+#define SNAKEBODY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+#include "Cell.h"
+#include "Rules.h"
+
+// Žiedinis buferis gyvatės kūnui: galva pridedama ir uodega pašalinama per O(1).
+// Indeksas 0 visada yra galva, size() - 1 - uodega.
+// Laikomi tik galvos ir uodegos langeliai, o kiekvienam kitam segmentui - 2 bitų kryptis
+// į jo kaimyną arčiau galvos, todėl milijono segmentų gyvatė užima ~250 KB.
+// Gretimi segmentai visada turi būti gretimi langeliai.
+class SnakeBody {
+private:
+    std::vector<uint64_t> links; // 32 kryptys viename žodyje
+    size_t capacity; // visada dvejeto laipsnis
+    size_t head; // galvos vieta buferyje
+    size_t count;
+    size_t mask;
+    Cell headCell;
+    Cell tailCell;
+    Direction getLink(size_t slot) const {
+        return static_cast<Direction>((links[slot >> 5] >> ((slot & 31) * 2)) & 3);
+    }
+    void setLink(size_t slot, Direction direction);
+    void grow();
+public:
+    // Eina nuo galvos iki uodegos, kiekviename žingsnyje atstatydamas langelį iš krypties
+    class const_iterator {
+    private:
+        const SnakeBody* body;
+        size_t index;
+        Cell cell;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Cell;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Cell*;
+        using reference = const Cell&;
+
+        const_iterator(const SnakeBody* body, size_t index, Cell cell) : body(body), index(index), cell(cell) {}
+        reference operator*() const { return cell; }
+        pointer operator->() const { return &cell; }
+        const_iterator& operator++() {
+            if (++index < body->count) {
+                cell = moveCell(cell, oppositeDirection(body->getLink(body->getSlot(index))));
+            }
+            return *this;
+        }
+        const_iterator operator++(int) { const_iterator old = *this; ++*this; return old; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+    };
+
+    explicit SnakeBody(size_t capacity = 16);
+    void pushFront(Cell cell);
+    // Galva pasislenka duota kryptimi; greitesnis už pushFront(Cell), nes kryptis jau žinoma
+    void pushFront(Direction direction);
+    void popBack();
+    void clear();
+    Cell front() const { return headCell; }
+    Cell back() const { return tailCell; }
+    // O(i): segmentai atstatomi einant nuo galvos; visam kūnui naudoti iteratorių
+    Cell operator[](size_t i) const;
+    size_t size() const { return count; }
+    // Vieta buferyje, kurioje laikomas i-tasis segmentas; nekinta, kol segmentas yra kūne
+    size_t getSlot(size_t i) const { return (head + i) & mask; }
+    size_t getCapacity() const { return capacity; }
+    // Kiek baitų užima krypčių buferis
+    size_t getMemoryUsage() const { return links.size() * sizeof(uint64_t); }
+    // Krypčių buferis ir galvos vieta, kad kūną būtų galima nukopijuoti žodžiais (Snapshot.h)
+    const uint64_t* getLinkWords() const { return links.data(); }
+    size_t getLinkWordCount() const { return links.size(); }
+    size_t getHeadSlot() const { return head; }
+    // Perima nukopijuotą krypčių buferį; wordCount * 32 turi būti dvejeto laipsnis ne mažesnis už 32
+    void assign(const uint64_t* words, size_t wordCount, size_t headSlot, size_t length, Cell front, Cell back);
+    bool empty() const { return count == 0; }
+    const_iterator begin() const { return const_iterator(this, 0, headCell); }
+    const_iterator end() const { return const_iterator(this, count, tailCell); }
+};
+
+#endif // SNAKEBODY_H
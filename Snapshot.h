@@ -0,0 +1,52 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "Board.h"
+#include "Cell.h"
+#include "Random.h"
+#include "Rules.h"
+
+// Mažiausias dvejeto laipsnis, ne mažesnis už n ir už 32 (SnakeBody žiedo talpa)
+constexpr size_t snapshotRingCapacity(size_t n) {
+    size_t capacity = 32;
+    while (capacity < n) {
+        capacity *= 2;
+    }
+    return capacity;
+}
+
+// Visa simuliacijos būsena fiksuoto dydžio masyvuose, kad paieškos algoritmai galėtų ją
+// klonuoti vienu memcpy. Kūnas laikomas taip pat kaip SnakeBody - 2 bitų kryptimis žiede,
+// o užimtumas - bitų lauku kartu su laisvų langelių medžiu, todėl Simulation::save() ir
+// restore() tik kopijuoja žodžius ir neišskiria atminties. 30x30 lentai struktūra užima ~530 baitų.
+template <typename BoardT>
+struct Snapshot {
+    // Po mirtino žingsnio kūne gali būti CELLS + 1 segmentas (galva už lentos)
+    static constexpr size_t LINK_WORDS = snapshotRingCapacity(BoardT::CELLS + 1) / 32;
+
+    uint64_t links[LINK_WORDS]; // naudojami tik pirmi linkWords žodžių
+    typename BoardT::Occupancy occupied;
+    uint32_t freeTree[BoardT::WORDS + 1]; // OccupancyGrid laisvų langelių medis
+    uint32_t freeCount;
+    uint32_t linkWords;
+    uint32_t headSlot;
+    uint32_t length;
+    Cell head;
+    Cell tail;
+    Cell food;
+    Direction direction;
+    int32_t pendingGrowth;
+    int32_t score;
+    bool gameOver;
+    bool won;
+    Random::State random;
+    Random::State start;
+    uint64_t hash; // Simulation::getHash()
+};
+
+static_assert(std::is_trivially_copyable<Snapshot<GameBoard>>::value, "Snapshot must be copyable with memcpy");
+
+#endif // SNAPSHOT_H
@@ -0,0 +1,333 @@
+#include <cstdint>
+#include <cstdio>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Autopilot.h"
+#include "FreeCellIndex.h"
+#include "HamiltonianController.h"
+#include "Keyframe.h"
+#include "MctsController.h"
+#include "OccupancyGrid.h"
+#include "Random.h"
+#include "Replay.h"
+#include "ReplayCorpus.h"
+#include "ReplayCorpusWriter.h"
+#include "ReplayPlayer.h"
+#include "ReplayRecorder.h"
+#include "Simulation.h"
+
+// Patikrinimai, kad inkrementiškai palaikomos struktūros sutampa su perskaičiuotomis iš naujo:
+// autopiloto atstumų laukas, Zobrist maiša, būsenos išsaugojimas ir įrašų atkūrimas, laisvų langelių rodyklė;
+// taip pat, kad Hamiltono valdiklis, perėmęs partiją vidury, nebežūsta atkūręs kūno tvarką,
+// o fone vykdoma medžio paieška parenka tuos pačius ėjimus kaip ir laukiant jos.
+// Vykdoma per ctest; grąžina ne nulį, jei bent vienas patikrinimas nepavyko.
+
+static int checks = 0;
+static int failures = 0;
+
+static void check(bool condition, const char* what, int game, uint32_t tick) {
+    ++checks;
+    if (!condition) {
+        // Only the first few are printed; one broken invariant usually fails every later step too
+        if (failures < 20) {
+            std::printf("FAILED %s (game %d, tick %u)\n", what, game, tick);
+        }
+        ++failures;
+    }
+}
+
+static bool sameState(const SimulationState& a, const SimulationState& b) {
+    return a.body == b.body && a.direction == b.direction && a.food == b.food &&
+           a.pendingGrowth == b.pendingGrowth && a.score == b.score && a.gameOver == b.gameOver &&
+           a.won == b.won && a.random.key == b.random.key && a.random.counter == b.random.counter &&
+           a.start.key == b.start.key && a.start.counter == b.start.counter;
+}
+
+// Mostly the autopilot's move, sometimes a random one, so games both grow long and wander
+static Direction chooseMove(const Simulation& simulation, Direction planned, Random& random) {
+    if (random.below(4) != 0) {
+        return planned;
+    }
+    Direction direction = static_cast<Direction>(random.below(4));
+    return simulation.isFree(moveCell(simulation.getHead(), direction)) ? direction : planned;
+}
+
+// Plain BFS from the food over cells the body does not occupy
+static std::vector<uint32_t> referenceDistances(const Simulation& simulation) {
+    int width = simulation.getWidth();
+    int height = simulation.getHeight();
+    std::vector<uint32_t> distances(static_cast<size_t>(width) * height, Autopilot::UNREACHABLE);
+    Cell food = simulation.getFood();
+    if (!simulation.isFree(food)) {
+        return distances;
+    }
+    std::queue<Cell> open;
+    distances[food.y * width + food.x] = 0;
+    open.push(food);
+    while (!open.empty()) {
+        Cell cell = open.front();
+        open.pop();
+        for (int k = 0; k < 4; ++k) {
+            Cell next = moveCell(cell, static_cast<Direction>(k));
+            if (simulation.isFree(next) && distances[next.y * width + next.x] == Autopilot::UNREACHABLE) {
+                distances[next.y * width + next.x] = distances[cell.y * width + cell.x] + 1;
+                open.push(next);
+            }
+        }
+    }
+    return distances;
+}
+
+static void testAutopilotField() {
+    const int SIZES[][2] = {{30, 30}, {12, 9}, {7, 5}, {16, 16}};
+    Random policy(1);
+    for (int game = 0; game < 40; ++game) {
+        int width = SIZES[game % 4][0];
+        int height = SIZES[game % 4][1];
+        Simulation simulation(width, height, static_cast<uint64_t>(game));
+        Autopilot autopilot(width, height);
+        for (uint32_t tick = 0; tick < 3000 && !simulation.isGameOver(); ++tick) {
+            Direction planned = autopilot.decide(simulation);
+            std::vector<uint32_t> expected = referenceDistances(simulation);
+            bool same = true;
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    same = same && autopilot.getDistance(Cell{x, y}) == expected[y * width + x];
+                }
+            }
+            check(same, "autopilot field matches a full BFS", game, tick);
+            simulation.step(chooseMove(simulation, planned, policy));
+        }
+    }
+}
+
+// Taken over mid-game, the controller may die while it brings the body back into cycle order,
+// but never afterwards
+static void testHamiltonianTakeover() {
+    for (int game = 0; game < 12; ++game) {
+        Simulation simulation(Board30::WIDTH, Board30::HEIGHT, static_cast<uint64_t>(game));
+        Autopilot autopilot(Board30::WIDTH, Board30::HEIGHT);
+        uint32_t tick = 0;
+        for (; tick < 60 + 90 * static_cast<uint32_t>(game) && !simulation.isGameOver(); ++tick) {
+            simulation.step(autopilot.decide(simulation));
+        }
+        HamiltonianController controller(Board30::WIDTH, Board30::HEIGHT);
+        controller.invalidate();
+        bool recovering = true;
+        for (; tick < 200000 && !simulation.isGameOver(); ++tick) {
+            Direction direction = controller.decide(simulation);
+            recovering = controller.isRecovering();
+            simulation.step(direction);
+        }
+        check(!simulation.isGameOver() || simulation.isWon() || recovering,
+              "hamiltonian controller survives once the body is in cycle order", game, tick);
+    }
+}
+
+// With one thread the search is deterministic, so collecting it later must not change a single move
+static void testMctsInBackground() {
+    MctsController<Board30> blocking(1, 1, 200);
+    MctsController<Board30> background(1, 1, 200);
+    Simulation first(Board30::WIDTH, Board30::HEIGHT, 7);
+    Simulation second(Board30::WIDTH, Board30::HEIGHT, 7);
+    for (uint32_t tick = 0; tick < 150 && !first.isGameOver(); ++tick) {
+        Direction expected = blocking.decide(first);
+        bool started = background.start(second);
+        // A second search cannot start while the first still owns the root
+        check(started && !background.start(second), "one background search at a time", 0, tick);
+        while (!background.isReady()) {
+            std::this_thread::yield();
+        }
+        check(background.finish() == expected, "background search picks the blocking move", 0, tick);
+        first.step(expected);
+        second.step(expected);
+    }
+    // A cancelled search leaves the controller ready for the next one
+    check(background.start(second), "search starts", 0, 0);
+    background.cancel();
+    check(!background.isSearching() && background.start(second), "search restarts after cancel", 0, 0);
+    background.finish();
+}
+
+static void testZobristHash() {
+    Random policy(2);
+    for (int game = 0; game < 60; ++game) {
+        int width = 8 + game % 23;
+        int height = 6 + game % 17;
+        Simulation simulation(width, height, static_cast<uint64_t>(game));
+        Autopilot autopilot(width, height);
+        Simulation copy(width, height);
+        for (uint32_t tick = 0; tick < 3000 && !simulation.isGameOver(); ++tick) {
+            simulation.step(chooseMove(simulation, autopilot.decide(simulation), policy));
+            // setState() computes the hash from scratch
+            copy.setState(simulation.getState());
+            check(copy.getHash() == simulation.getHash(), "incremental hash matches a full recompute", game,
+                  tick);
+        }
+    }
+}
+
+static void testSnapshotRoundTrip() {
+    Random policy(3);
+    for (int game = 0; game < 30; ++game) {
+        Simulation simulation(Board30::WIDTH, Board30::HEIGHT, static_cast<uint64_t>(game));
+        Autopilot autopilot(Board30::WIDTH, Board30::HEIGHT);
+        Snapshot<Board30> snapshot;
+        uint32_t savedAt = 50 + 37 * static_cast<uint32_t>(game);
+        std::vector<Direction> moves;
+        for (uint32_t tick = 0; tick < 3000 && !simulation.isGameOver(); ++tick) {
+            if (tick == savedAt) {
+                check(simulation.save(snapshot), "snapshot save", game, tick);
+            }
+            Direction move = chooseMove(simulation, autopilot.decide(simulation), policy);
+            if (tick >= savedAt) {
+                moves.push_back(move);
+            }
+            simulation.step(move);
+        }
+        if (moves.empty()) {
+            continue;
+        }
+        // A different game restored from the snapshot must play out exactly like the original
+        Simulation restored(Board30::WIDTH, Board30::HEIGHT, 999);
+        restored.step(UP);
+        check(restored.restore(snapshot), "snapshot restore", game, savedAt);
+        for (Direction move : moves) {
+            restored.step(move);
+        }
+        check(sameState(restored.getState(), simulation.getState()), "restored game replays identically", game,
+              savedAt);
+        check(restored.getHash() == simulation.getHash(), "restored game keeps the hash", game, savedAt);
+    }
+}
+
+static void testReplayRoundTrip() {
+    const char* CORPUS_FILE = "snake_tests_corpus.snc";
+    const uint32_t KEYFRAME_INTERVAL = 64;
+    Random policy(4);
+    std::vector<Replay> replays;
+    std::vector<std::vector<SimulationState>> histories;
+    for (int game = 0; game < 12; ++game) {
+        int width = game % 2 == 0 ? 30 : 13;
+        int height = game % 2 == 0 ? 30 : 11;
+        Simulation simulation(width, height, static_cast<uint64_t>(game));
+        Autopilot autopilot(width, height);
+        ReplayRecorder recorder;
+        recorder.start(simulation);
+        std::vector<SimulationState> history{simulation.getState()};
+        for (uint32_t tick = 0; tick < 2000 && !simulation.isGameOver(); ++tick) {
+            simulation.step(chooseMove(simulation, autopilot.decide(simulation), policy));
+            recorder.record(simulation);
+            history.push_back(simulation.getState());
+        }
+
+        std::vector<uint8_t> bytes;
+        recorder.getReplay().encode(bytes);
+        Replay decoded;
+        check(decoded.decode(bytes.data(), bytes.size()), "replay decodes", game, 0);
+        ReplayPlayer player(decoded);
+        player.runToEnd();
+        check(player.matchesRecording(), "replay reaches the recorded score", game, decoded.ticks);
+        check(sameState(player.getSimulation().getState(), history.back()), "replay ends in the recorded state",
+              game, decoded.ticks);
+
+        for (uint32_t tick = 0; tick < history.size(); tick += 97) {
+            bytes.clear();
+            encodeKeyframe(bytes, tick, history[tick]);
+            const uint8_t* data = bytes.data();
+            uint32_t decodedTick = 0;
+            SimulationState state;
+            bool ok = decodeKeyframe(data, bytes.data() + bytes.size(), decodedTick, state);
+            check(ok && decodedTick == tick && sameState(state, history[tick]), "keyframe round-trip", game, tick);
+        }
+        replays.push_back(decoded);
+        histories.push_back(history);
+    }
+
+    ReplayCorpusWriter writer(KEYFRAME_INTERVAL);
+    bool written = writer.open(CORPUS_FILE);
+    for (const Replay& replay : replays) {
+        written = writer.add(replay) && written;
+    }
+    written = writer.close() && written;
+    check(written, "corpus written", 0, 0);
+    ReplayCorpus corpus;
+    check(corpus.openFromFile(CORPUS_FILE), "corpus opens", 0, 0);
+    check(corpus.getEpisodeCount() == replays.size(), "corpus episode count", 0, 0);
+    for (size_t episode = 0; episode < corpus.getEpisodeCount(); ++episode) {
+        Replay replay;
+        check(corpus.getReplay(episode, replay), "corpus replay", static_cast<int>(episode), 0);
+        ReplayPlayer player(replay);
+        const std::vector<SimulationState>& history = histories[episode];
+        // Backwards and forwards, on and between keyframes
+        for (uint32_t tick : {replay.ticks, 0u, KEYFRAME_INTERVAL, replay.ticks / 2, KEYFRAME_INTERVAL + 1,
+                              replay.ticks > 0 ? replay.ticks - 1 : 0}) {
+            if (tick > replay.ticks) {
+                continue;
+            }
+            bool sought = corpus.seek(episode, tick, player);
+            check(sought && player.getTick() == tick && sameState(player.getSimulation().getState(), history[tick]),
+                  "corpus seek lands on the recorded state", static_cast<int>(episode), tick);
+        }
+    }
+    corpus.close();
+    std::remove(CORPUS_FILE);
+}
+
+static void testFreeCellIndex() {
+    Random random(5);
+    for (int round = 0; round < 300; ++round) {
+        int width = 1 + static_cast<int>(random.below(70));
+        int height = 1 + static_cast<int>(random.below(40));
+        OccupancyGrid grid(width, height);
+        std::vector<bool> occupied(static_cast<size_t>(width) * height, false);
+        for (int change = 0; change < 200; ++change) {
+            Cell cell{static_cast<int>(random.below(width)), static_cast<int>(random.below(height))};
+            bool set = random.below(3) != 0;
+            if (set) {
+                grid.set(cell);
+            } else {
+                grid.clear(cell);
+            }
+            occupied[cell.y * width + cell.x] = set;
+        }
+        std::vector<Cell> free;
+        for (int y = 0; y < height; ++y) {
+            for (int x = 0; x < width; ++x) {
+                if (!occupied[y * width + x]) {
+                    free.push_back(Cell{x, y});
+                }
+            }
+        }
+        check(grid.getFreeCount() == free.size(), "free count matches a scan", round, 0);
+        bool same = grid.getFreeCount() == free.size();
+        for (size_t n = 0; same && n < free.size(); ++n) {
+            same = grid.getFreeCell(n) == free[n];
+        }
+        check(same, "n-th free cell matches a row-major scan", round, 0);
+    }
+}
+
+int main() {
+    struct {
+        const char* name;
+        void (*run)();
+    } tests[] = {
+            {"autopilot field", testAutopilotField},
+            {"hamiltonian takeover", testHamiltonianTakeover},
+            {"mcts in background", testMctsInBackground},
+            {"zobrist hash", testZobristHash},
+            {"snapshot round-trip", testSnapshotRoundTrip},
+            {"replay round-trip", testReplayRoundTrip},
+            {"free cell index", testFreeCellIndex},
+    };
+    for (const auto& test : tests) {
+        int checksBefore = checks;
+        int failuresBefore = failures;
+        test.run();
+        std::printf("%-24s %7d checks %5d failed\n", test.name, checks - checksBefore, failures - failuresBefore);
+    }
+    return failures == 0 ? 0 : 1;
+}
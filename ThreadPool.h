@@ -0,0 +1,48 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Gijų telkinys su darbų vagyste: kiekviena gija turi savo užduočių eilę,
+// ima naujausias užduotis iš jos galo, o ištuštėjus - vagia seniausias iš kitų gijų eilių.
+class ThreadPool {
+private:
+    struct Queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    std::mutex wakeMutex;
+    std::condition_variable wakeUp;
+    std::condition_variable allDone;
+    std::atomic<size_t> queued; // užduotys eilėse
+    std::atomic<size_t> pending; // pateiktos, bet dar neįvykdytos užduotys
+    std::atomic<size_t> nextQueue;
+    bool stopping;
+    void workerLoop(size_t index);
+    bool popTask(size_t index, std::function<void()>& task);
+public:
+    // 0 - tiek gijų, kiek branduolių
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    // Galima kviesti ir iš užduoties vidaus; tada užduotis dedama į tos gijos eilę
+    void submit(std::function<void()> task);
+    // Laukia, kol bus įvykdytos visos užduotys; negalima kviesti iš užduoties vidaus
+    void wait();
+    // Ar visos pateiktos užduotys jau įvykdytos; nelaukia, todėl tinka kviesti kiekviename kadre
+    bool isIdle() const { return pending == 0; }
+    size_t size() const { return workers.size(); }
+};
+
+#endif // THREADPOOL_H
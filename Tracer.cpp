@@ -0,0 +1,193 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const size_t BUFFER_CAPACITY = size_t(1) << 14; // events per thread between flushes
+const std::chrono::milliseconds FLUSH_PERIOD(50);
+
+// Fields are atomics so the flusher may read a slot while its owner overwrites it;
+// such a torn read is detected by the position check and dropped
+struct Slot {
+    std::atomic<const char*> name;
+    std::atomic<uint64_t> time; // nanoseconds << 1 | 1 for an end event
+};
+
+struct ThreadBuffer {
+    std::unique_ptr<Slot[]> slots;
+    std::atomic<uint64_t> written; // only the owning thread advances it
+    uint64_t read; // only the flusher touches it
+    const char* name;
+    uint32_t id;
+    bool described; // thread name already written to the file
+};
+
+std::mutex registryMutex; // guards buffers and the file, never taken by a recording thread
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer* localBuffer = nullptr;
+
+std::FILE* file = nullptr;
+bool firstEvent = true;
+uint64_t epoch = 0;
+uint64_t dropped = 0;
+
+std::thread flusher;
+std::mutex flusherMutex;
+std::condition_variable flusherWake;
+bool stopping = false;
+
+uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void record(const char* name, bool isEnd) {
+    ThreadBuffer* buffer = localBuffer;
+    if (buffer == nullptr) {
+        return;
+    }
+    uint64_t position = buffer->written.load(std::memory_order_relaxed);
+    Slot& slot = buffer->slots[position & (BUFFER_CAPACITY - 1)];
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.time.store(now() << 1 | static_cast<uint64_t>(isEnd), std::memory_order_relaxed);
+    buffer->written.store(position + 1, std::memory_order_release);
+}
+
+void writeSeparator() {
+    std::fputs(firstEvent ? "\n" : ",\n", file);
+    firstEvent = false;
+}
+
+// Called with registryMutex held
+void drain() {
+    struct Event {
+        const char* name;
+        uint64_t time;
+    };
+    std::vector<Event> events;
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        if (!buffer->described) {
+            writeSeparator();
+            std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s\"}}",
+                         buffer->id, buffer->name);
+            buffer->described = true;
+        }
+        uint64_t written = buffer->written.load(std::memory_order_acquire);
+        if (written - buffer->read > BUFFER_CAPACITY) {
+            dropped += written - buffer->read - BUFFER_CAPACITY;
+            buffer->read = written - BUFFER_CAPACITY;
+        }
+        events.clear();
+        for (uint64_t position = buffer->read; position < written; ++position) {
+            const Slot& slot = buffer->slots[position & (BUFFER_CAPACITY - 1)];
+            events.push_back(Event{slot.name.load(std::memory_order_relaxed), slot.time.load(std::memory_order_relaxed)});
+        }
+        // Slots the owner lapped while they were being copied may be torn
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = buffer->written.load(std::memory_order_relaxed);
+        size_t skip = 0;
+        if (after - buffer->read > BUFFER_CAPACITY) {
+            skip = static_cast<size_t>(std::min<uint64_t>(after - buffer->read - BUFFER_CAPACITY, events.size()));
+            dropped += skip;
+        }
+        buffer->read = written;
+        for (size_t i = skip; i < events.size(); ++i) {
+            // An event stamped just before start() may only now become visible
+            uint64_t time = std::max(events[i].time >> 1, epoch);
+            writeSeparator();
+            std::fprintf(file, "{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%u,\"ts\":%.3f}", events[i].name,
+                         (events[i].time & 1) ? 'E' : 'B', buffer->id, (time - epoch) / 1000.0);
+        }
+    }
+    std::fflush(file);
+}
+
+void flushLoop() {
+    std::unique_lock<std::mutex> lock(flusherMutex);
+    while (!stopping) {
+        flusherWake.wait_for(lock, FLUSH_PERIOD, [] { return stopping; });
+        std::lock_guard<std::mutex> registryLock(registryMutex);
+        drain();
+    }
+}
+
+} // namespace
+
+std::atomic<bool> Tracer::active(false);
+
+bool Tracer::start(const std::string& path) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (file != nullptr) {
+        return false;
+    }
+    file = std::fopen(path.c_str(), "w");
+    if (file == nullptr) {
+        return false;
+    }
+    std::fputs("{\"traceEvents\":[", file);
+    firstEvent = true;
+    dropped = 0;
+    epoch = now();
+    // Anything recorded before now belongs to an earlier session
+    for (const std::unique_ptr<ThreadBuffer>& buffer : buffers) {
+        buffer->read = buffer->written.load(std::memory_order_acquire);
+        buffer->described = false;
+    }
+    stopping = false;
+    flusher = std::thread(flushLoop);
+    active.store(true, std::memory_order_relaxed);
+    return true;
+}
+
+void Tracer::stop() {
+    if (!active.exchange(false, std::memory_order_relaxed)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(flusherMutex);
+        stopping = true;
+    }
+    flusherWake.notify_one();
+    flusher.join();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    drain();
+    std::fputs("\n]}\n", file);
+    std::fclose(file);
+    file = nullptr;
+}
+
+void Tracer::attachThread(const char* name) {
+    if (localBuffer != nullptr) {
+        return;
+    }
+    std::unique_ptr<ThreadBuffer> buffer(new ThreadBuffer());
+    buffer->slots.reset(new Slot[BUFFER_CAPACITY]());
+    buffer->written.store(0, std::memory_order_relaxed);
+    buffer->read = 0;
+    buffer->name = name;
+    buffer->described = false;
+    localBuffer = buffer.get();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->id = static_cast<uint32_t>(buffers.size() + 1);
+    buffers.push_back(std::move(buffer));
+}
+
+void Tracer::begin(const char* name) {
+    record(name, false);
+}
+
+void Tracer::end(const char* name) {
+    record(name, true);
+}
+
+uint64_t Tracer::getDroppedCount() {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    return dropped;
+}
@@ -0,0 +1,52 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// Chrome / Perfetto trace-event įrašymas. Kiekviena prijungta gija turi savo žiedinį buferį,
+// į kurį rašo tik ji pati, be užraktų; foninė gija kas 50 ms buferius ištuština į JSON failą,
+// kurį galima atidaryti chrome://tracing arba ui.perfetto.dev. Jei gija prirašo daugiau,
+// nei telpa buferyje iki ištuštinimo, seniausi įvykiai prarandami ir suskaičiuojami.
+// Įvykius rašo tik gijos, iškvietusios attachThread(), todėl paieškos gijos, kurios simuliuoja
+// milijonus žingsnių, failo neužtvindo. Išjungus lieka vienas atominio kintamojo skaitymas.
+class Tracer {
+private:
+    static std::atomic<bool> active;
+public:
+    // Pradeda rašyti į failą; false, jei jau rašoma arba failo nepavyko atidaryti
+    static bool start(const std::string& path);
+    // Ištuština likusius įvykius ir užbaigia failą
+    static void stop();
+    static bool isActive() { return active.load(std::memory_order_relaxed); }
+    // Prijungia kviečiančią giją; name rodomas laiko juostoje. Kviečiama vieną kartą gijai
+    static void attachThread(const char* name);
+    // name turi gyventi iki stop() (pvz. eilutės literalas)
+    static void begin(const char* name);
+    static void end(const char* name);
+    // Kiek įvykių prarasta nuo start(), nes buferis persipildė
+    static uint64_t getDroppedCount();
+};
+
+// Pažymi bloko pradžią ir pabaigą: TraceScope trace("Game::update");
+class TraceScope {
+private:
+    const char* name;
+    bool recording;
+public:
+    explicit TraceScope(const char* name) : name(name), recording(Tracer::isActive()) {
+        if (recording) {
+            Tracer::begin(name);
+        }
+    }
+    ~TraceScope() {
+        if (recording) {
+            Tracer::end(name);
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+};
+
+#endif // TRACER_H
@@ -0,0 +1,55 @@
+#include "TranspositionTable.h"
+
+TranspositionTable::TranspositionTable(size_t bytes) {
+    size_t count = 1;
+    while (count * 2 * sizeof(Bucket) <= bytes) {
+        count *= 2;
+    }
+    buckets.reset(new Bucket[count]);
+    mask = count - 1;
+    clear();
+}
+
+bool TranspositionTable::probe(uint64_t key, uint64_t& data) const {
+    // An empty slot (0, 0) would otherwise read as an entry for key 0
+    if (key == 0) {
+        return false;
+    }
+    const Bucket& bucket = buckets[key & mask];
+    for (const Entry& entry : bucket.entries) {
+        uint64_t value = entry.data.load(std::memory_order_relaxed);
+        if ((entry.check.load(std::memory_order_relaxed) ^ value) == key) {
+            data = value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void TranspositionTable::store(uint64_t key, uint64_t data) {
+    if (key == 0) {
+        return;
+    }
+    Bucket& bucket = buckets[key & mask];
+    // The same key or an empty slot first; otherwise evict the slot the key's top bits pick
+    Entry* target = &bucket.entries[key >> 62];
+    for (Entry& entry : bucket.entries) {
+        uint64_t value = entry.data.load(std::memory_order_relaxed);
+        uint64_t check = entry.check.load(std::memory_order_relaxed);
+        if ((check ^ value) == key || (check == 0 && value == 0)) {
+            target = &entry;
+            break;
+        }
+    }
+    target->data.store(data, std::memory_order_relaxed);
+    target->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+void TranspositionTable::clear() {
+    for (size_t i = 0; i <= mask; ++i) {
+        for (Entry& entry : buckets[i].entries) {
+            entry.check.store(0, std::memory_order_relaxed);
+            entry.data.store(0, std::memory_order_relaxed);
+        }
+    }
+}
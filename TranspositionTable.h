@@ -0,0 +1,39 @@
+#ifndef TRANSPOSITIONTABLE_H
+#define TRANSPOSITIONTABLE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Riboto dydžio perstatų lentelė, kuria kelios paieškos gijos dalijasi be užraktų.
+// Kiekvienas įrašas - du atominiai žodžiai: duomenys ir (raktas XOR duomenys). Jei dvi gijos
+// rašo vienu metu ir žodžiai susimaišo, XOR nebesutampa ir probe() įrašo tiesiog nemato,
+// todėl sugadintas įrašas niekada negrąžinamas. Įrašai grupuojami po 4 į vieną 64 baitų
+// eilutę; pilnoje grupėje perrašomas įrašas, kurį parenka rakto bitai.
+// Duomenų 64 bitų prasmę apibrėžia paieškos algoritmas. Raktas 0 rezervuotas tuščiam įrašui:
+// jo probe() nieko neranda, o store() ignoruoja.
+class TranspositionTable {
+private:
+    struct Entry {
+        std::atomic<uint64_t> check; // raktas XOR duomenys
+        std::atomic<uint64_t> data;
+    };
+    struct alignas(64) Bucket {
+        Entry entries[4];
+    };
+    std::unique_ptr<Bucket[]> buckets;
+    size_t mask; // grupių skaičius - 1
+public:
+    // Dydis suapvalinamas žemyn iki dvejeto laipsnio grupių
+    explicit TranspositionTable(size_t bytes = size_t(16) << 20);
+    TranspositionTable(const TranspositionTable&) = delete;
+    TranspositionTable& operator=(const TranspositionTable&) = delete;
+    bool probe(uint64_t key, uint64_t& data) const;
+    void store(uint64_t key, uint64_t data);
+    // Negalima kviesti, kol kitos gijos naudoja lentelę
+    void clear();
+    size_t getCapacity() const { return (mask + 1) * 4; }
+};
+
+#endif // TRANSPOSITIONTABLE_H
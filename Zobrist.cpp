@@ -0,0 +1,17 @@
+#include "Zobrist.h"
+
+// Fixed, so hashes are the same in every run and can be compared across processes
+const uint64_t ZOBRIST_SEED = 0x5A0B2157ull;
+
+Zobrist::Zobrist(int width, int height)
+    : width(width), height(height),
+      key(Random::makeKey(ZOBRIST_SEED, (static_cast<uint64_t>(width) << 32) | static_cast<uint32_t>(height))) {
+    for (int i = 0; i < 4; ++i) {
+        directionKeys[i] = Random::at(key, i);
+    }
+    // No growth left is the common case; a zero key keeps it out of the hash
+    growthKeys[0] = 0;
+    for (int i = 1; i < 16; ++i) {
+        growthKeys[i] = Random::at(key, 4 + i);
+    }
+}
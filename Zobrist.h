@@ -0,0 +1,49 @@
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include "Cell.h"
+#include "Random.h"
+#include "Rules.h"
+
+// Zobrist raktai būsenos maišos reikšmei: atsitiktinis 64 bitų skaičius kiekvienam užimtam langeliui,
+// galvos ir maisto vietai, krypčiai ir likusiam augimui. Būsenos maiša - jos raktų XOR, todėl
+// pasikeitus vienam langeliui ji atnaujinama per O(1). Raktai priklauso tik nuo lentos dydžio,
+// todėl visos to paties dydžio simuliacijos tą pačią būseną maišo vienodai.
+// Langelių raktai nelaikomi lentelėje, o skaičiuojami iš langelio numerio (Random::at), todėl
+// atmintis nepriklauso nuo lentos dydžio: 4096x4096 lentelė užimtų ~400 MB.
+class Zobrist {
+private:
+    // Pirmi srauto skaičiai - kryptys ir augimas, po jų kiekvienam langeliui po tris
+    static constexpr uint64_t FIRST_CELL_KEY = 4 + 16;
+
+    int width;
+    int height;
+    uint64_t key;
+    uint64_t directionKeys[4];
+    uint64_t growthKeys[16];
+    bool onBoard(Cell cell) const {
+        return static_cast<unsigned>(cell.x) < static_cast<unsigned>(width) &&
+               static_cast<unsigned>(cell.y) < static_cast<unsigned>(height);
+    }
+    // kind: 0 - kūnas, 1 - galva, 2 - maistas
+    uint64_t cellKey(Cell cell, uint64_t kind) const {
+        if (!onBoard(cell)) {
+            return 0;
+        }
+        uint64_t index = static_cast<uint64_t>(cell.y) * width + cell.x;
+        return Random::at(key, FIRST_CELL_KEY + index * 3 + kind);
+    }
+public:
+    Zobrist(int width, int height);
+    // Langeliai už lentos (pvz. galva po mirtino žingsnio, maistas laimėjus) turi raktą 0
+    uint64_t body(Cell cell) const { return cellKey(cell, 0); }
+    uint64_t head(Cell cell) const { return cellKey(cell, 1); }
+    uint64_t food(Cell cell) const { return cellKey(cell, 2); }
+    uint64_t direction(Direction direction) const { return directionKeys[direction]; }
+    // Augimas ilgesnis nei 15 žingsnių maišomas kaip 15
+    uint64_t growth(int steps) const { return growthKeys[steps < 15 ? steps : 15]; }
+};
+
+#endif // ZOBRIST_H
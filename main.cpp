@@ -1,7 +1,67 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include "ArenaViewer.h"
 #include "Game.h"
+#include "Replay.h"
+#include "ReplayCorpusWriter.h"
+#include "ReplayViewer.h"
+
+// Supakuoja atskirus partijų įrašus (.snr) į vieną rinkinį, kurį galima peržiūrėti
+static int packReplays(const std::string& output, char* inputs[], int count) {
+    ReplayCorpusWriter writer;
+    if (!writer.open(output)) {
+        std::cerr << "Could not create " << output << std::endl;
+        return 1;
+    }
+    int packed = 0;
+    for (int i = 0; i < count; ++i) {
+        Replay replay;
+        if (!replay.loadFromFile(inputs[i])) {
+            // One damaged recording should not lose the rest
+            std::cerr << "Skipping " << inputs[i] << ": not a valid replay" << std::endl;
+            continue;
+        }
+        if (!writer.add(replay)) {
+            std::cerr << "Could not write " << output << std::endl;
+            return 1;
+        }
+        ++packed;
+    }
+    if (!writer.close()) {
+        std::cerr << "Could not write " << output << std::endl;
+        return 1;
+    }
+    std::cout << "Packed " << packed << " of " << count << " replays into " << output << std::endl;
+    return 0;
+}
 
 // inicializuoja žaidimą
-int main() {
+int main(int argc, char* argv[]) {
+    // --arena [gyvačių skaičius] paleidžia daugelio gyvačių areną
+    if (argc > 1 && std::string(argv[1]) == "--arena") {
+        int snakes = argc > 2 ? std::atoi(argv[2]) : 100;
+        ArenaViewer arena(static_cast<size_t>(snakes < 1 ? 1 : snakes > 65535 ? 65535 : snakes));
+        arena.run();
+        return 0;
+    }
+
+    // --pack rinkinys.snc partija1.snr partija2.snr ...
+    if (argc > 1 && std::string(argv[1]) == "--pack") {
+        if (argc < 4) {
+            std::cerr << "Usage: " << argv[0] << " --pack out.snc in.snr..." << std::endl;
+            return 1;
+        }
+        return packReplays(argv[2], argv + 3, argc - 3);
+    }
+
+    // Jei nurodytas įrašų rinkinio failas, atidaroma jo peržiūra
+    if (argc > 1) {
+        ReplayViewer viewer(argv[1]);
+        viewer.run();
+        return 0;
+    }
+
     // Sukuriamas žaidimo objektas ir paleidžiamas žaidimas
     Game game;
     game.run();